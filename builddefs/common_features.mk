@@ -287,6 +287,7 @@ ifneq ($(strip $(FLASH_DRIVER)), none)
     else
         OPT_DEFS += -DFLASH_ENABLE -DFLASH_DRIVER -DFLASH_DRIVER_$(strip $(shell echo $(FLASH_DRIVER) | tr '[:lower:]' '[:upper:]'))
 		COMMON_VPATH += $(DRIVER_PATH)/flash
+        SRC += flash_stream.c
         ifeq ($(strip $(FLASH_DRIVER)),spi)
             SRC += flash_spi.c
             SPI_DRIVER_REQUIRED = yes
@@ -682,6 +683,7 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     # Determine which (if any) transport files are required
     ifneq ($(strip $(SPLIT_TRANSPORT)), custom)
         QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport.c \
+                       $(QUANTUM_DIR)/split_common/transport_stats.c \
                        $(QUANTUM_DIR)/split_common/transactions.c
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
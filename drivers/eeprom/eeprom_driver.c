@@ -83,3 +83,17 @@ void eeprom_driver_format(bool erase) {
     (void)erase; /* The default implementation assumes that the eeprom must be erased in order to be usable. */
     eeprom_driver_erase();
 }
+
+void eeprom_driver_begin_transaction(void) __attribute__((weak));
+void eeprom_driver_begin_transaction(void) {
+    /* The default implementation writes through immediately, so there is nothing to group. */
+}
+
+void eeprom_driver_commit_transaction(void) __attribute__((weak));
+void eeprom_driver_commit_transaction(void) {}
+
+void eeprom_driver_task(void) __attribute__((weak));
+void eeprom_driver_task(void) {}
+
+void eeprom_driver_flush(void) __attribute__((weak));
+void eeprom_driver_flush(void) {}
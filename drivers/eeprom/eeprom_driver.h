@@ -22,3 +22,13 @@
 void eeprom_driver_init(void);
 void eeprom_driver_format(bool erase);
 void eeprom_driver_erase(void);
+
+// Groups the writes up until the matching commit, so that drivers able to do so can store them as one
+void eeprom_driver_begin_transaction(void);
+void eeprom_driver_commit_transaction(void);
+
+// Gives drivers with deferred work, such as background consolidation, a chance to make progress
+void eeprom_driver_task(void);
+
+// Blocks until all deferred writes have reached the underlying storage
+void eeprom_driver_flush(void);
@@ -33,7 +33,8 @@
     there is nothing to override during linkage.
 */
 
-#include "wait.h"
+#include "timer.h"
+#include "util.h"
 #include "i2c_master.h"
 #include "eeprom.h"
 #include "eeprom_driver.h"
@@ -42,7 +43,6 @@
 // #define DEBUG_EEPROM_OUTPUT
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-#    include "timer.h"
 #    include "debug.h"
 #endif // DEBUG_EEPROM_OUTPUT
 
@@ -54,13 +54,129 @@ static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     }
 }
 
-void eeprom_driver_init(void) {
-    i2c_init();
+_Static_assert(EXTERNAL_EEPROM_WRITE_QUEUE_PAGES <= 255, "EXTERNAL_EEPROM_WRITE_QUEUE_PAGES must be no more than 255");
+
+// Whether the EEPROM may still be busy with its internal write cycle
+static bool     write_in_progress = false;
+static uint8_t  write_device      = 0;
+static uint16_t write_timer       = 0;
+
+// Whether WP has been released for the writes in progress
+static bool write_unprotected = false;
+
+#if EXTERNAL_EEPROM_WRITE_QUEUE_PAGES > 0
+typedef struct {
+    uintptr_t page;  // address of the start of the page
+    uint16_t  start; // offset of the first queued byte within the page
+    uint16_t  end;   // offset just past the last queued byte within the page
+    uint8_t   data[EXTERNAL_EEPROM_PAGE_SIZE];
+} eeprom_i2c_queued_page_t;
+
+static eeprom_i2c_queued_page_t write_queue[EXTERNAL_EEPROM_WRITE_QUEUE_PAGES];
+static uint8_t                  write_queue_head  = 0;
+static uint8_t                  write_queue_count = 0;
+
+static inline eeprom_i2c_queued_page_t *write_queue_at(uint8_t index) {
+    return &write_queue[(write_queue_head + index) % (EXTERNAL_EEPROM_WRITE_QUEUE_PAGES)];
+}
+#endif // EXTERNAL_EEPROM_WRITE_QUEUE_PAGES > 0
+
+static inline void write_protect(bool enable) {
 #if defined(EXTERNAL_EEPROM_WP_PIN)
-    /* We are setting the WP pin to high in a way that requires at least two bit-flips to change back to 0 */
-    gpio_write_pin(EXTERNAL_EEPROM_WP_PIN, 1);
-    gpio_set_pin_input_high(EXTERNAL_EEPROM_WP_PIN);
+    if (enable) {
+        /* We are setting the WP pin to high in a way that requires at least two bit-flips to change back to 0 */
+        gpio_write_pin(EXTERNAL_EEPROM_WP_PIN, 1);
+        gpio_set_pin_input_high(EXTERNAL_EEPROM_WP_PIN);
+    } else {
+        gpio_set_pin_output(EXTERNAL_EEPROM_WP_PIN);
+        gpio_write_pin(EXTERNAL_EEPROM_WP_PIN, 0);
+    }
+#else
+    (void)enable;
+#endif
+    write_unprotected = !enable;
+}
+
+/*
+    Checks whether the EEPROM has finished the last page write, either by it
+    acknowledging its address again or by the write cycle time having elapsed.
+*/
+static bool eeprom_i2c_is_ready(void) {
+    if (!write_in_progress) {
+        return true;
+    }
+#if defined(EXTERNAL_EEPROM_ACK_POLLING)
+    if (i2c_ping_address(write_device, 10) == I2C_STATUS_SUCCESS) {
+        write_in_progress = false;
+        return true;
+    }
 #endif
+    if (timer_elapsed(write_timer) > (EXTERNAL_EEPROM_WRITE_TIME)) {
+        write_in_progress = false;
+        return true;
+    }
+    return false;
+}
+
+static void eeprom_i2c_wait_ready(void) {
+    while (!eeprom_i2c_is_ready()) {
+    }
+}
+
+/*
+    Sends a single page write to the EEPROM, which carries on with its write
+    cycle in the background.
+*/
+static void eeprom_i2c_write_page(uintptr_t target_addr, const uint8_t *data, uint16_t length) {
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
+    fill_target_address(complete_packet, (const void *)target_addr);
+    memcpy(&complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE], data, length);
+
+#if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
+    dprintf("[EEPROM W] 0x%04X: ", ((int)target_addr));
+    for (uint16_t i = 0; i < length; i++) {
+        dprintf(" %02X", (int)(data[i]));
+    }
+    dprintf("\n");
+#endif // DEBUG_EEPROM_OUTPUT
+
+    if (!write_unprotected) {
+        write_protect(false);
+    }
+    write_device = EXTERNAL_EEPROM_I2C_ADDRESS(target_addr);
+    i2c_transmit(write_device, complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + length, 100);
+    write_in_progress = (EXTERNAL_EEPROM_WRITE_TIME) > 0;
+    write_timer       = timer_read();
+}
+
+/*
+    Makes progress on outstanding writes without blocking, handing the next
+    queued page to the EEPROM once it's ready. Returns true once everything has
+    been written.
+*/
+static bool eeprom_i2c_service(void) {
+    if (!eeprom_i2c_is_ready()) {
+        return false;
+    }
+#if EXTERNAL_EEPROM_WRITE_QUEUE_PAGES > 0
+    if (write_queue_count > 0) {
+        eeprom_i2c_queued_page_t *entry = write_queue_at(0);
+        eeprom_i2c_write_page(entry->page + entry->start, &entry->data[entry->start], entry->end - entry->start);
+        write_queue_head = (write_queue_head + 1) % (EXTERNAL_EEPROM_WRITE_QUEUE_PAGES);
+        --write_queue_count;
+        return false;
+    }
+#endif // EXTERNAL_EEPROM_WRITE_QUEUE_PAGES > 0
+    // Only re-assert WP once the last write has completed, not on every idle task call
+    if (write_unprotected) {
+        write_protect(true);
+    }
+    return true;
+}
+
+void eeprom_driver_init(void) {
+    i2c_init();
+    write_protect(true);
 }
 
 void eeprom_driver_format(bool erase) {
@@ -80,19 +196,43 @@ void eeprom_driver_erase(void) {
     for (uint32_t addr = 0; addr < EXTERNAL_EEPROM_BYTE_COUNT; addr += EXTERNAL_EEPROM_PAGE_SIZE) {
         eeprom_write_block(buf, (void *)(uintptr_t)addr, EXTERNAL_EEPROM_PAGE_SIZE);
     }
+    eeprom_driver_flush();
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("EEPROM erase took %ldms to complete\n", ((long)(timer_read32() - start)));
 #endif
 }
 
+void eeprom_driver_task(void) {
+    eeprom_i2c_service();
+}
+
+void eeprom_driver_flush(void) {
+    while (!eeprom_i2c_service()) {
+    }
+}
+
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
     uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
     fill_target_address(complete_packet, addr);
 
+    eeprom_i2c_wait_ready();
     i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
     i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
 
+#if EXTERNAL_EEPROM_WRITE_QUEUE_PAGES > 0
+    // Queued writes haven't reached the EEPROM yet, so apply them in order on top
+    uintptr_t address = (uintptr_t)addr;
+    for (uint8_t i = 0; i < write_queue_count; ++i) {
+        eeprom_i2c_queued_page_t *entry = write_queue_at(i);
+        uintptr_t                 start = MAX(entry->page + entry->start, address);
+        uintptr_t                 end   = MIN(entry->page + entry->end, address + len);
+        if (start < end) {
+            memcpy((uint8_t *)buf + (start - address), &entry->data[start - entry->page], end - start);
+        }
+    }
+#endif // EXTERNAL_EEPROM_WRITE_QUEUE_PAGES > 0
+
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("[EEPROM R] 0x%04X: ", ((int)addr));
     for (size_t i = 0; i < len; ++i) {
@@ -103,46 +243,54 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    uint8_t   complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
-    uint8_t * read_buf    = (uint8_t *)buf;
-    uintptr_t target_addr = (uintptr_t)addr;
-
-#if defined(EXTERNAL_EEPROM_WP_PIN)
-    gpio_set_pin_output(EXTERNAL_EEPROM_WP_PIN);
-    gpio_write_pin(EXTERNAL_EEPROM_WP_PIN, 0);
-#endif
+    const uint8_t *read_buf    = (const uint8_t *)buf;
+    uintptr_t      target_addr = (uintptr_t)addr;
 
     while (len > 0) {
         uintptr_t page_offset  = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
-        int       write_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
+        uint16_t  write_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
         if (write_length > len) {
             write_length = len;
         }
 
-        fill_target_address(complete_packet, (const void *)target_addr);
-        for (uint8_t i = 0; i < write_length; i++) {
-            complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + i] = read_buf[i];
-        }
+#if EXTERNAL_EEPROM_WRITE_QUEUE_PAGES > 0
+        uintptr_t                 page  = target_addr - page_offset;
+        eeprom_i2c_queued_page_t *entry = NULL;
 
-#if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-        dprintf("[EEPROM W] 0x%04X: ", ((int)target_addr));
-        for (uint8_t i = 0; i < write_length; i++) {
-            dprintf(" %02X", (int)(read_buf[i]));
+        // Extend the latest queued write to the same page, as long as the result is contiguous
+        for (uint8_t i = write_queue_count; i > 0; --i) {
+            if (write_queue_at(i - 1)->page == page) {
+                entry = write_queue_at(i - 1);
+                if (page_offset > entry->end || page_offset + write_length < entry->start) {
+                    entry = NULL;
+                }
+                break;
+            }
         }
-        dprintf("\n");
-#endif // DEBUG_EEPROM_OUTPUT
 
-        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
-        wait_ms(EXTERNAL_EEPROM_WRITE_TIME);
+        if (entry == NULL) {
+            while (write_queue_count == (EXTERNAL_EEPROM_WRITE_QUEUE_PAGES)) {
+                eeprom_i2c_service();
+            }
+            entry        = write_queue_at(write_queue_count++);
+            entry->page  = page;
+            entry->start = page_offset;
+            entry->end   = page_offset + write_length;
+        } else {
+            entry->start = MIN(entry->start, page_offset);
+            entry->end   = MAX(entry->end, page_offset + write_length);
+        }
+        memcpy(&entry->data[page_offset], read_buf, write_length);
+#else
+        eeprom_i2c_wait_ready();
+        eeprom_i2c_write_page(target_addr, read_buf, write_length);
+#endif // EXTERNAL_EEPROM_WRITE_QUEUE_PAGES > 0
 
         read_buf += write_length;
         target_addr += write_length;
         len -= write_length;
     }
 
-#if defined(EXTERNAL_EEPROM_WP_PIN)
-    /* We are setting the WP pin to high in a way that requires at least two bit-flips to change back to 0 */
-    gpio_write_pin(EXTERNAL_EEPROM_WP_PIN, 1);
-    gpio_set_pin_input_high(EXTERNAL_EEPROM_WP_PIN);
-#endif
+    // Get the first page going straight away if the EEPROM is idle
+    eeprom_i2c_service();
 }
@@ -123,3 +123,20 @@
 #ifndef EXTERNAL_EEPROM_WRITE_TIME
 #    define EXTERNAL_EEPROM_WRITE_TIME 5
 #endif
+
+/*
+    Define EXTERNAL_EEPROM_ACK_POLLING to treat the EEPROM as ready as soon as
+    it acknowledges its address again after a page write, rather than always
+    waiting the full EXTERNAL_EEPROM_WRITE_TIME. The write cycle time is still
+    used as an upper bound.
+*/
+
+/*
+    The number of page writes that can be queued in RAM. Writes return as soon
+    as they've been queued, and the queue is drained in the background by the
+    housekeeping task. Each queued page uses EXTERNAL_EEPROM_PAGE_SIZE bytes of
+    RAM, 0 disables the queue.
+*/
+#ifndef EXTERNAL_EEPROM_WRITE_QUEUE_PAGES
+#    define EXTERNAL_EEPROM_WRITE_QUEUE_PAGES 0
+#endif
@@ -20,6 +20,18 @@ void eeprom_driver_erase(void) {
     wear_leveling_erase();
 }
 
+void eeprom_driver_begin_transaction(void) {
+    wear_leveling_transaction_begin();
+}
+
+void eeprom_driver_commit_transaction(void) {
+    wear_leveling_transaction_commit();
+}
+
+void eeprom_driver_task(void) {
+    wear_leveling_task();
+}
+
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
     wear_leveling_read((uint32_t)addr, buf, len);
 }
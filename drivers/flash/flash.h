@@ -121,6 +121,94 @@ flash_status_t flash_read_range(uint32_t addr, void *buf, size_t len);
  */
 flash_status_t flash_write_range(uint32_t addr, const void *buf, size_t len);
 
+/**
+ * @brief Initiates writing a range of flash memory.
+ *
+ * This function sends the first page and returns, without waiting for it to be programmed. The remaining pages are
+ * sent one at a time by flash_write_task(), each once the chip has finished programming the one before. Any other
+ * flash operation sends the pages still outstanding first. The buffer must stay untouched until all pages have been
+ * sent, i.e. until flash_write_task() stops returning FLASH_STATUS_BUSY or another flash function has been called.
+ *
+ * @param addr The address of the range to write.
+ * @param buf A pointer to the buffer to write to the range.
+ * @param len The length of the range to write.
+ *
+ * @return FLASH_STATUS_SUCCESS if the first page was successfully sent, FLASH_STATUS_BAD_ADDRESS if the address is out of bounds, FLASH_STATUS_TIMEOUT if the flash is busy, or FLASH_STATUS_ERROR if an error occurred.
+ */
+flash_status_t flash_begin_write_range(uint32_t addr, const void *buf, size_t len);
+
+/**
+ * @brief Continues a write started by flash_begin_write_range() without blocking.
+ *
+ * This function sends the next page if the chip has finished programming the previous one. It is called from the
+ * housekeeping task, and drivers that write synchronously don't need to implement it.
+ *
+ * @return FLASH_STATUS_SUCCESS once all pages have been sent, FLASH_STATUS_BUSY while pages are still outstanding, or FLASH_STATUS_ERROR if an error occurred, which abandons the rest of the write.
+ */
+flash_status_t flash_write_task(void);
+
+/**
+ * @brief Waits for a write operation to complete.
+ *
+ * This function sends any pages of a write started by flash_begin_write_range() that are still outstanding, and waits
+ * for the last one to finish programming.
+ *
+ * @return FLASH_STATUS_SUCCESS if the write completed successfully, FLASH_STATUS_TIMEOUT if the flash was still busy, or FLASH_STATUS_ERROR if an error occurred.
+ */
+flash_status_t flash_wait_write_range(void);
+
+/**
+ * @brief The size of the read-ahead buffer of a flash read stream, in bytes.
+ */
+#ifndef FLASH_READ_STREAM_BUFFER_SIZE
+#    define FLASH_READ_STREAM_BUFFER_SIZE 32
+#endif
+
+/**
+ * @brief A sequential reader over a region of flash memory.
+ *
+ * Small reads are served from a read-ahead buffer which is refilled with a single bulk read, while reads at least as
+ * large as the buffer go straight to the flash.
+ */
+typedef struct flash_read_stream_t {
+    uint32_t address;   //< The flash address of the start of the stream.
+    uint32_t length;    //< The length of the stream in bytes.
+    uint32_t position;  //< The offset of the next byte to be read.
+    uint32_t buffered;  //< The offset of the first byte in the buffer.
+    uint16_t available; //< The number of valid bytes in the buffer.
+    uint8_t  buffer[FLASH_READ_STREAM_BUFFER_SIZE];
+} flash_read_stream_t;
+
+/**
+ * @brief Initializes a flash read stream.
+ *
+ * @param stream The stream to initialize.
+ * @param addr The flash address of the start of the stream.
+ * @param len The length of the stream in bytes.
+ */
+void flash_read_stream_init(flash_read_stream_t *stream, uint32_t addr, uint32_t len);
+
+/**
+ * @brief Reads the next bytes from a flash read stream.
+ *
+ * @param stream The stream to read from.
+ * @param buf A pointer to the buffer to read into.
+ * @param len The number of bytes to read.
+ *
+ * @return The number of bytes read, which is less than requested at the end of the stream or if an error occurred.
+ */
+size_t flash_read_stream(flash_read_stream_t *stream, void *buf, size_t len);
+
+/**
+ * @brief Moves the read position of a flash read stream.
+ *
+ * @param stream The stream to seek.
+ * @param offset The new read position, relative to the start of the stream.
+ *
+ * @return FLASH_STATUS_SUCCESS if the position was updated, or FLASH_STATUS_BAD_ADDRESS if it's past the end of the stream.
+ */
+flash_status_t flash_read_stream_seek(flash_read_stream_t *stream, uint32_t offset);
+
 #ifdef __cplusplus
 }
 #endif
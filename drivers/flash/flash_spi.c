@@ -51,31 +51,98 @@
 #define FLASH_FLAG_WIP 0x01 /* Write in progress bit */
 #define FLASH_FLAG_WEL 0x02 /* Write enable latch bit */
 
+#if defined(EXTERNAL_FLASH_SPI_FAST_READ)
+#    define FLASH_CMD_READ_DATA FLASH_CMD_FASTREAD
+#else
+#    define FLASH_CMD_READ_DATA FLASH_CMD_READ
+#endif
+
 // #define DEBUG_FLASH_SPI_OUTPUT
 
+/*
+    Whether a program or erase may still be in progress. Nothing else sets the
+    write-in-progress bit, so the status register only needs to be polled after
+    one of those has been issued -- or after a reset, when it's unknown.
+*/
+static bool spi_flash_maybe_busy = true;
+
+/*
+    The pages of a write started by flash_begin_write_range() that haven't
+    been sent yet. Each is sent once the chip has finished programming the one
+    before, from flash_write_task() or ahead of any other flash operation.
+*/
+static struct {
+    const uint8_t *buf;
+    uint32_t       addr;
+    size_t         len;
+} spi_flash_write;
+
+static flash_status_t spi_flash_program_page(void);
+
 static bool spi_flash_start(void) {
     return spi_start(EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN, EXTERNAL_FLASH_SPI_LSBFIRST, EXTERNAL_FLASH_SPI_MODE, EXTERNAL_FLASH_SPI_CLOCK_DIVISOR);
 }
 
-static flash_status_t spi_flash_wait_while_busy_multiplier(int multiplier) {
-    flash_status_t response = FLASH_STATUS_SUCCESS;
+static flash_status_t spi_flash_poll_while_busy(int multiplier) {
+    if (!spi_flash_maybe_busy) {
+        return FLASH_STATUS_SUCCESS;
+    }
+
+    bool res = spi_flash_start();
+    if (!res) {
+        dprint("Failed to start SPI! [spi flash wait while busy]\n");
+        return FLASH_STATUS_ERROR;
+    }
+
+    /* The status register is output continuously for as long as the chip is selected. */
+    flash_status_t response = FLASH_STATUS_TIMEOUT;
     uint32_t       deadline = timer_read32() + ((EXTERNAL_FLASH_SPI_TIMEOUT)*multiplier);
+    spi_write(FLASH_CMD_RDSR);
     do {
-        if (timer_read32() >= deadline) {
-            response = FLASH_STATUS_TIMEOUT;
+        spi_status_t status = spi_read();
+        if (status < 0) {
+            response = status;
+            break;
+        }
+        if (!((uint8_t)status & FLASH_FLAG_WIP)) {
+            response = FLASH_STATUS_SUCCESS;
             break;
         }
+    } while (timer_read32() < deadline);
+    spi_stop();
 
-        response = flash_is_busy();
-    } while (response == FLASH_STATUS_BUSY);
+    if (response == FLASH_STATUS_SUCCESS) {
+        spi_flash_maybe_busy = false;
+    }
     return response;
 }
 
+/* Waits for the chip to go idle, sending the rest of a write that is still in progress first. */
+static flash_status_t spi_flash_wait_while_busy_multiplier(int multiplier) {
+    while (spi_flash_write.len > 0) {
+        flash_status_t response = spi_flash_poll_while_busy(1);
+        if (response != FLASH_STATUS_SUCCESS) {
+            spi_flash_write.len = 0;
+            return response;
+        }
+        response = spi_flash_program_page();
+        if (response != FLASH_STATUS_SUCCESS) {
+            return response;
+        }
+    }
+    return spi_flash_poll_while_busy(multiplier);
+}
+
 static flash_status_t spi_flash_wait_while_busy(void) {
     return spi_flash_wait_while_busy_multiplier(1);
 }
 
-flash_status_t flash_is_busy(void) {
+/* Reads the write-in-progress bit once. */
+static flash_status_t spi_flash_check_busy(void) {
+    if (!spi_flash_maybe_busy) {
+        return FLASH_STATUS_SUCCESS;
+    }
+
     bool res = spi_flash_start();
     if (!res) {
         dprint("Failed to start SPI! [spi flash wait while busy]\n");
@@ -91,7 +158,19 @@ flash_status_t flash_is_busy(void) {
     }
 
     uint8_t sr = (uint8_t)status;
-    return (sr & FLASH_FLAG_WIP) ? FLASH_STATUS_BUSY : FLASH_STATUS_SUCCESS;
+    if (sr & FLASH_FLAG_WIP) {
+        return FLASH_STATUS_BUSY;
+    }
+    spi_flash_maybe_busy = false;
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_is_busy(void) {
+    flash_status_t response = flash_write_task();
+    if (response != FLASH_STATUS_SUCCESS) {
+        return response;
+    }
+    return spi_flash_check_busy();
 }
 
 static flash_status_t spi_flash_write_enable(void) {
@@ -123,7 +202,8 @@ static flash_status_t spi_flash_write_disable(void) {
 /* This function is used for read transfer, write transfer and erase transfer. */
 static flash_status_t spi_flash_transaction(uint8_t cmd, uint32_t addr, uint8_t *data, size_t len) {
     flash_status_t response = FLASH_STATUS_SUCCESS;
-    uint8_t        buffer[EXTERNAL_FLASH_ADDRESS_SIZE + 1];
+    uint8_t        buffer[EXTERNAL_FLASH_ADDRESS_SIZE + 2];
+    size_t         length = EXTERNAL_FLASH_ADDRESS_SIZE + 1;
 
     buffer[0] = cmd;
     for (int i = 0; i < EXTERNAL_FLASH_ADDRESS_SIZE; ++i) {
@@ -131,17 +211,23 @@ static flash_status_t spi_flash_transaction(uint8_t cmd, uint32_t addr, uint8_t
         addr >>= 8;
     }
 
+    /* Fast read clocks out a dummy byte before the data. */
+    if (cmd == FLASH_CMD_FASTREAD) {
+        buffer[length++] = 0x00;
+    }
+
     bool res = spi_flash_start();
     if (!res) {
         dprint("Failed to start SPI! [spi flash transmit]\n");
         return FLASH_STATUS_ERROR;
     }
 
-    response = spi_transmit(buffer, sizeof(buffer));
+    response = spi_transmit(buffer, length);
 
     if ((!response) && (data != NULL)) {
         switch (cmd) {
             case FLASH_CMD_READ:
+            case FLASH_CMD_FASTREAD:
                 response = spi_receive(data, len);
                 break;
             case FLASH_CMD_PP:
@@ -187,6 +273,7 @@ flash_status_t flash_begin_erase_chip(void) {
     }
     spi_write(FLASH_CMD_CE);
     spi_stop();
+    spi_flash_maybe_busy = true;
     return FLASH_STATUS_SUCCESS;
 }
 
@@ -234,6 +321,7 @@ flash_status_t flash_erase_sector(uint32_t addr) {
 
     /* Erase Sector. */
     response = spi_flash_transaction(FLASH_CMD_SE, addr, NULL, 0);
+    spi_flash_maybe_busy = true;
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to erase sector! [spi flash erase sector]\n");
         return response;
@@ -274,6 +362,7 @@ flash_status_t flash_erase_block(uint32_t addr) {
 
     /* Erase Block. */
     response = spi_flash_transaction(FLASH_CMD_BE, addr, NULL, 0);
+    spi_flash_maybe_busy = true;
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to erase block! [spi flash erase block]\n");
         return response;
@@ -302,7 +391,7 @@ flash_status_t flash_read_range(uint32_t addr, void *buf, size_t len) {
     }
 
     /* Perform read. */
-    response = spi_flash_transaction(FLASH_CMD_READ, addr, read_buf, len);
+    response = spi_flash_transaction(FLASH_CMD_READ_DATA, addr, read_buf, len);
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to read block! [spi flash read block]\n");
         memset(read_buf, 0, len);
@@ -320,64 +409,99 @@ flash_status_t flash_read_range(uint32_t addr, void *buf, size_t len) {
     return response;
 }
 
-flash_status_t flash_write_range(uint32_t addr, const void *buf, size_t len) {
-    flash_status_t response  = FLASH_STATUS_SUCCESS;
-    uint8_t *      write_buf = (uint8_t *)buf;
-
-    while (len > 0) {
-        uint32_t page_offset  = addr % EXTERNAL_FLASH_PAGE_SIZE;
-        size_t   write_length = EXTERNAL_FLASH_PAGE_SIZE - page_offset;
-        if (write_length > len) {
-            write_length = len;
-        }
-
-        /* Wait for the write-in-progress bit to be cleared. */
-        response = spi_flash_wait_while_busy();
-        if (response != FLASH_STATUS_SUCCESS) {
-            dprint("Failed to check WIP flag! [spi flash write block]\n");
-            return response;
-        }
+/* Sends the next page of the write in progress. The chip must be idle. */
+static flash_status_t spi_flash_program_page(void) {
+    uint32_t page_offset  = spi_flash_write.addr % EXTERNAL_FLASH_PAGE_SIZE;
+    size_t   write_length = EXTERNAL_FLASH_PAGE_SIZE - page_offset;
+    if (write_length > spi_flash_write.len) {
+        write_length = spi_flash_write.len;
+    }
 
-        /* Enable writes. */
-        response = spi_flash_write_enable();
-        if (response != FLASH_STATUS_SUCCESS) {
-            dprint("Failed to write-enable! [spi flash write block]\n");
-            return response;
-        }
+    /* Enable writes. */
+    flash_status_t response = spi_flash_write_enable();
+    if (response != FLASH_STATUS_SUCCESS) {
+        dprint("Failed to write-enable! [spi flash write block]\n");
+        spi_flash_write.len = 0;
+        return response;
+    }
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_FLASH_SPI_OUTPUT)
-        dprintf("[SPI FLASH W] 0x%08lx: ", addr);
-        for (size_t i = 0; i < write_length; i++) {
-            dprintf(" %02X", (int)(uint8_t)(write_buf[i]));
-        }
-        dprintf("\n");
+    dprintf("[SPI FLASH W] 0x%08lx: ", spi_flash_write.addr);
+    for (size_t i = 0; i < write_length; i++) {
+        dprintf(" %02X", (int)(uint8_t)(spi_flash_write.buf[i]));
+    }
+    dprintf("\n");
 #endif // DEBUG_FLASH_SPI_OUTPUT
 
-        /* Perform the write. */
-        response = spi_flash_transaction(FLASH_CMD_PP, addr, write_buf, write_length);
-        if (response != FLASH_STATUS_SUCCESS) {
-            dprint("Failed to write block! [spi flash write block]\n");
-            return response;
-        }
-
-        write_buf += write_length;
-        addr += write_length;
-        len -= write_length;
+    /* Perform the write. The write enable latch is cleared by the chip once the page has been programmed. */
+    response             = spi_flash_transaction(FLASH_CMD_PP, spi_flash_write.addr, (uint8_t *)spi_flash_write.buf, write_length);
+    spi_flash_maybe_busy = true;
+    if (response != FLASH_STATUS_SUCCESS) {
+        dprint("Failed to write block! [spi flash write block]\n");
+        spi_flash_write_disable();
+        spi_flash_write.len = 0;
+        return response;
     }
 
-    /* Wait for the write-in-progress bit to be cleared. */
-    response = spi_flash_wait_while_busy();
+    spi_flash_write.buf += write_length;
+    spi_flash_write.addr += write_length;
+    spi_flash_write.len -= write_length;
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_begin_write_range(uint32_t addr, const void *buf, size_t len) {
+    /* Wait for the previous write to finish, along with anything else. */
+    flash_status_t response = spi_flash_wait_while_busy();
     if (response != FLASH_STATUS_SUCCESS) {
         dprint("Failed to check WIP flag! [spi flash write block]\n");
         return response;
     }
 
-    /* Disable writes. */
-    response = spi_flash_write_disable();
+    if (len == 0) {
+        return FLASH_STATUS_SUCCESS;
+    }
+
+    spi_flash_write.buf  = (const uint8_t *)buf;
+    spi_flash_write.addr = addr;
+    spi_flash_write.len  = len;
+    return spi_flash_program_page();
+}
+
+flash_status_t flash_write_task(void) {
+    if (spi_flash_write.len == 0) {
+        return FLASH_STATUS_SUCCESS;
+    }
+
+    /* Only send the next page once the chip is done with the last one. */
+    flash_status_t response = spi_flash_check_busy();
+    if (response != FLASH_STATUS_SUCCESS) {
+        if (response != FLASH_STATUS_BUSY) {
+            dprint("Failed to check WIP flag! [spi flash write block]\n");
+            spi_flash_write.len = 0;
+        }
+        return response;
+    }
+
+    response = spi_flash_program_page();
     if (response != FLASH_STATUS_SUCCESS) {
-        dprint("Failed to write-disable! [spi flash write block]\n");
         return response;
     }
+    return spi_flash_write.len > 0 ? FLASH_STATUS_BUSY : FLASH_STATUS_SUCCESS;
+}
 
+flash_status_t flash_wait_write_range(void) {
+    flash_status_t response = spi_flash_wait_while_busy();
+    if (response != FLASH_STATUS_SUCCESS) {
+        dprint("Failed to check WIP flag! [spi flash write block]\n");
+    }
     return response;
 }
+
+flash_status_t flash_write_range(uint32_t addr, const void *buf, size_t len) {
+    flash_status_t response = flash_begin_write_range(addr, buf, len);
+    if (response != FLASH_STATUS_SUCCESS) {
+        return response;
+    }
+
+    return flash_wait_write_range();
+}
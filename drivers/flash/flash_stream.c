@@ -0,0 +1,68 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "flash.h"
+#include "util.h"
+
+__attribute__((weak)) flash_status_t flash_write_task(void) {
+    return FLASH_STATUS_SUCCESS;
+}
+
+void flash_read_stream_init(flash_read_stream_t *stream, uint32_t addr, uint32_t len) {
+    stream->address   = addr;
+    stream->length    = len;
+    stream->position  = 0;
+    stream->buffered  = 0;
+    stream->available = 0;
+}
+
+size_t flash_read_stream(flash_read_stream_t *stream, void *buf, size_t len) {
+    uint8_t *read_buf = (uint8_t *)buf;
+    size_t   total    = 0;
+
+    len = MIN(len, stream->length - stream->position);
+    while (len > 0) {
+        /* Serve what we can from the read-ahead buffer. */
+        if (stream->position >= stream->buffered && stream->position < stream->buffered + stream->available) {
+            size_t offset = stream->position - stream->buffered;
+            size_t count  = MIN(len, stream->available - offset);
+            memcpy(read_buf, &stream->buffer[offset], count);
+            read_buf += count;
+            stream->position += count;
+            total += count;
+            len -= count;
+            continue;
+        }
+
+        /* Large reads go straight to the flash. */
+        if (len >= FLASH_READ_STREAM_BUFFER_SIZE) {
+            if (flash_read_range(stream->address + stream->position, read_buf, len) != FLASH_STATUS_SUCCESS) {
+                break;
+            }
+            stream->position += len;
+            total += len;
+            break;
+        }
+
+        /* Refill the read-ahead buffer. */
+        uint16_t count = MIN(FLASH_READ_STREAM_BUFFER_SIZE, stream->length - stream->position);
+        if (flash_read_range(stream->address + stream->position, stream->buffer, count) != FLASH_STATUS_SUCCESS) {
+            stream->available = 0;
+            break;
+        }
+        stream->buffered  = stream->position;
+        stream->available = count;
+    }
+
+    return total;
+}
+
+flash_status_t flash_read_stream_seek(flash_read_stream_t *stream, uint32_t offset) {
+    if (offset > stream->length) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    stream->position = offset;
+    return FLASH_STATUS_SUCCESS;
+}
@@ -21,6 +21,23 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_DIRTY_REGIONS
+/**
+ * @def This controls the maximum number of separate dirty regions tracked by each surface. Each region is transferred
+ *      to the target with its own viewport, so updates in opposite corners don't transfer everything in between.
+ *      Setting this to 1 tracks a single bounding box.
+ */
+#    define SURFACE_DIRTY_REGIONS 4
+#endif
+
+#ifndef SURFACE_DIRTY_REGION_MERGE_PIXELS
+/**
+ * @def The number of pixels considered equivalent to the overhead of setting up an extra viewport on the target.
+ *      Dirty regions are merged whenever doing so would transfer no more than this many extra pixels.
+ */
+#    define SURFACE_DIRTY_REGION_MERGE_PIXELS 64
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -29,24 +29,120 @@ void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport) {
     }
 }
 
+_Static_assert(SURFACE_DIRTY_REGIONS >= 1 && SURFACE_DIRTY_REGIONS <= 255, "SURFACE_DIRTY_REGIONS must be between 1 and 255");
+
+static inline uint32_t qp_surface_dirty_region_area(const surface_dirty_region_t *region) {
+    return (uint32_t)(region->r - region->l + 1) * (uint32_t)(region->b - region->t + 1);
+}
+
+static void qp_surface_dirty_region_include(surface_dirty_region_t *region, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    if (region->l > l) {
+        region->l = l;
+    }
+    if (region->t > t) {
+        region->t = t;
+    }
+    if (region->r < r) {
+        region->r = r;
+    }
+    if (region->b < b) {
+        region->b = b;
+    }
+}
+
+// Number of extra pixels the region would cover if it were grown to include the supplied area
+static uint32_t qp_surface_dirty_region_growth(const surface_dirty_region_t *region, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    surface_dirty_region_t grown = *region;
+    qp_surface_dirty_region_include(&grown, l, t, r, b);
+    return qp_surface_dirty_region_area(&grown) - qp_surface_dirty_region_area(region);
+}
+
+// Combines any other regions with the supplied one where the extra pixels cost less than another viewport
+static void qp_surface_merge_dirty_regions(surface_dirty_data_t *dirty, uint8_t index) {
+    bool merged;
+    do {
+        merged = false;
+        for (uint8_t i = 0; i < dirty->region_count; ++i) {
+            if (i == index) {
+                continue;
+            }
+
+            surface_dirty_region_t *region = &dirty->regions[index];
+            surface_dirty_region_t *other  = &dirty->regions[i];
+            if (qp_surface_dirty_region_growth(region, other->l, other->t, other->r, other->b) > qp_surface_dirty_region_area(other) + SURFACE_DIRTY_REGION_MERGE_PIXELS) {
+                continue;
+            }
+
+            // Fold the other region in, then fill its slot with the last one
+            qp_surface_dirty_region_include(region, other->l, other->t, other->r, other->b);
+            uint8_t last = --dirty->region_count;
+            if (i != last) {
+                dirty->regions[i] = dirty->regions[last];
+            }
+            if (index == last) {
+                index = i;
+            }
+
+            // The region has grown, so everything needs rechecking
+            merged = true;
+            break;
+        }
+    } while (merged);
+}
+
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
     // Maintain dirty region
+    bool grown = false;
     if (dirty->l > x) {
-        dirty->l        = x;
-        dirty->is_dirty = true;
+        dirty->l = x;
+        grown    = true;
     }
     if (dirty->r < x) {
-        dirty->r        = x;
-        dirty->is_dirty = true;
+        dirty->r = x;
+        grown    = true;
     }
     if (dirty->t > y) {
-        dirty->t        = y;
-        dirty->is_dirty = true;
+        dirty->t = y;
+        grown    = true;
     }
     if (dirty->b < y) {
-        dirty->b        = y;
+        dirty->b = y;
+        grown    = true;
+    }
+    if (grown) {
         dirty->is_dirty = true;
+    } else if (dirty->region_count == 1) {
+        return; // A lone region always matches the bounding box, so this pixel is already dirty
     }
+
+    // Most pixels land inside a region which is already dirty, so check that before working out any areas
+    for (uint8_t i = 0; i < dirty->region_count; ++i) {
+        const surface_dirty_region_t *region = &dirty->regions[i];
+        if (region->l <= x && x <= region->r && region->t <= y && y <= region->b) {
+            return; // Already dirty
+        }
+    }
+
+    // Find the region which needs to grow the least in order to include this pixel
+    uint8_t  best_index  = 0;
+    uint32_t best_growth = UINT32_MAX;
+    for (uint8_t i = 0; i < dirty->region_count; ++i) {
+        uint32_t growth = qp_surface_dirty_region_growth(&dirty->regions[i], x, y, x, y);
+        if (growth < best_growth) {
+            best_index  = i;
+            best_growth = growth;
+        }
+    }
+
+    // Pixels are mostly drawn in rows, so a region which at most doubles in size is likely to be filled in anyway --
+    // anything further away gets a region of its own while there's space
+    if (dirty->region_count < SURFACE_DIRTY_REGIONS && (dirty->region_count == 0 || best_growth > qp_surface_dirty_region_area(&dirty->regions[best_index]) + SURFACE_DIRTY_REGION_MERGE_PIXELS)) {
+        dirty->regions[dirty->region_count++] = (surface_dirty_region_t){.l = x, .t = y, .r = x, .b = y};
+        return;
+    }
+
+    qp_surface_dirty_region_include(&dirty->regions[best_index], x, y, x, y);
+    qp_surface_merge_dirty_regions(dirty, best_index);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -63,6 +159,9 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface->dirty.b        = surface->base.panel_height - 1;
     surface->dirty.is_dirty = true;
 
+    surface->dirty.region_count = 1;
+    surface->dirty.regions[0]   = (surface_dirty_region_t){.l = surface->dirty.l, .t = surface->dirty.t, .r = surface->dirty.r, .b = surface->dirty.b};
+
     return true;
 }
 
@@ -83,6 +182,7 @@ bool qp_surface_flush(painter_device_t device) {
     surface->dirty.l = surface->dirty.t = UINT16_MAX;
     surface->dirty.r = surface->dirty.b = 0;
     surface->dirty.is_dirty             = false;
+    surface->dirty.region_count         = 0;
     return true;
 }
 
@@ -122,9 +222,17 @@ bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t
         return false;
     }
 
-    // Offload to the pixdata transfer function
+    // Offload to the pixdata transfer function, once per dirty region
     surface_painter_driver_vtable_t *vtable = (surface_painter_driver_vtable_t *)surface_driver->driver_vtable;
-    bool                             ok     = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, entire_surface);
+    bool                             ok     = true;
+    if (entire_surface) {
+        ok = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, 0, 0, surface_driver->panel_width - 1, surface_driver->panel_height - 1);
+    } else {
+        for (uint8_t i = 0; ok && i < surface_handle->dirty.region_count; ++i) {
+            surface_dirty_region_t *region = &surface_handle->dirty.regions[i];
+            ok                             = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, region->l, region->t, region->r, region->b);
+        }
+    }
     if (!ok) {
         qp_dprintf("qp_surface_draw: fail (could not transfer pixel data)\n");
         return false;
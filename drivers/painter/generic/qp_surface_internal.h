@@ -13,15 +13,26 @@
 typedef struct surface_painter_driver_vtable_t {
     painter_driver_vtable_t base; // must be first, so it can be cast to/from the painter_driver_vtable_t* type
 
-    bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface);
+    bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 } surface_painter_driver_vtable_t;
 
+typedef struct surface_dirty_region_t {
+    uint16_t l;
+    uint16_t t;
+    uint16_t r;
+    uint16_t b;
+} surface_dirty_region_t;
+
 typedef struct surface_dirty_data_t {
     bool     is_dirty;
-    uint16_t l;
+    uint16_t l; // Bounding box of all the dirty regions
     uint16_t t;
     uint16_t r;
     uint16_t b;
+
+    // Separate regions, so that distant updates don't require transferring everything in between
+    uint8_t                region_count;
+    surface_dirty_region_t regions[SURFACE_DIRTY_REGIONS];
 } surface_dirty_data_t;
 
 typedef struct surface_viewport_data_t {
@@ -28,6 +28,18 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_TRANSPORT_FRAMED
+// executes several transactions in one exchange, see transport_frame_begin()
+bool soft_serial_transaction_frame(const uint8_t *sstd_indices, uint8_t count);
+#endif
+
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+// target pushes a transaction's target2initiator buffer without being asked
+bool soft_serial_target_notify(int sstd_index, uint8_t length);
+// initiator collects the transactions updated that way since the last call
+uint32_t soft_serial_initiator_notifications(bool *dropped);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -41,6 +41,15 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+_Static_assert((WEAR_LEVELING_BANK_SIZE) % (EXTERNAL_FLASH_SECTOR_SIZE) == 0, "Bank size must be a multiple of EXTERNAL_FLASH_SECTOR_SIZE");
+
+bool backing_store_erase_sector(uint32_t address, uint32_t *length) {
+    *length = (EXTERNAL_FLASH_SECTOR_SIZE);
+    return flash_erase_sector((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address) == FLASH_STATUS_SUCCESS;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
@@ -69,10 +78,16 @@ bool backing_store_read_bulk(uint32_t address, backing_store_int_t *values, size
 }
 
 bool backing_store_write_bulk(uint32_t address, backing_store_int_t *values, size_t item_count) {
-    uint32_t            offset = (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address;
-    size_t              index  = 0;
-    backing_store_int_t temp[WEAR_LEVELING_EXTERNAL_FLASH_BULK_COUNT];
+    uint32_t offset = (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address;
+    size_t   index  = 0;
+    // Kept around after returning, the flash driver sends its remaining pages from the housekeeping task
+    static backing_store_int_t temp[WEAR_LEVELING_EXTERNAL_FLASH_BULK_COUNT];
     do {
+        // The previous block may still be going out of the buffer
+        if (flash_wait_write_range() != FLASH_STATUS_SUCCESS) {
+            return false;
+        }
+
         // Copy out the block of data we want to transmit first
         size_t this_loop = MIN(item_count, WEAR_LEVELING_EXTERNAL_FLASH_BULK_COUNT);
         for (size_t i = 0; i < this_loop; ++i) {
@@ -87,8 +102,8 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t *values, siz
             temp[i] = ~temp[i];
         }
 
-        // Write out the block
-        if (flash_write_range(offset, temp, sizeof(backing_store_int_t) * this_loop) != FLASH_STATUS_SUCCESS) {
+        // Start writing out the block, the rest is sent in the background -- the next flash access finishes it first
+        if (flash_begin_write_range(offset, temp, sizeof(backing_store_int_t) * this_loop) != FLASH_STATUS_SUCCESS) {
             return false;
         }
 
@@ -3,6 +3,7 @@
 import datetime
 import math
 import re
+from collections import deque
 from pathlib import Path
 from string import Template
 from PIL import Image, ImageOps
@@ -454,3 +455,90 @@ def compress_bytes_qmk_rle(bytearray):
                 temp = []
                 repeat = False
     return output
+
+
+# QMK LZ parameters, see quantum_painter_lz.md
+QMK_LZ_WINDOW_SIZE = 1024
+QMK_LZ_MIN_MATCH = 3
+QMK_LZ_MAX_MATCH = 0xFFFF
+QMK_LZ_MAX_LITERALS = 128
+QMK_LZ_CHAIN_LENGTH = 32
+
+
+def _qmk_lz_append_literals(output, literals):
+    for n in range(0, len(literals), QMK_LZ_MAX_LITERALS):
+        run = literals[n:n + QMK_LZ_MAX_LITERALS]
+        output.append(len(run) - 1)
+        output.extend(run)
+    literals.clear()
+
+
+def _qmk_lz_append_match(output, length, offset):
+    encoded_length = length - QMK_LZ_MIN_MATCH
+    encoded_offset = offset - 1
+    output.append(0x80 | (min(encoded_length, 0x1F) << 2) | (encoded_offset >> 8))
+    output.append(encoded_offset & 0xFF)
+    if encoded_length >= 0x1F:
+        remaining = encoded_length - 0x1F
+        while remaining >= 0xFF:
+            output.append(0xFF)
+            remaining -= 0xFF
+        output.append(remaining)
+
+
+def _qmk_lz_find_match(data, pos, chains):
+    best_length = 0
+    best_offset = 0
+    max_length = min(QMK_LZ_MAX_MATCH, len(data) - pos)
+    for candidate in chains.get(data[pos:pos + QMK_LZ_MIN_MATCH], ()):
+        offset = pos - candidate
+        if offset > QMK_LZ_WINDOW_SIZE:
+            break  # chains are most recent first, so the rest are out of range too
+
+        # Matches may overlap the data they produce, the decoder copies byte by byte
+        length = QMK_LZ_MIN_MATCH
+        while length < max_length and data[candidate + length] == data[pos + length]:
+            length += 1
+        if length > best_length:
+            best_length = length
+            best_offset = offset
+            if length == max_length:
+                break
+    return (best_length, best_offset)
+
+
+def compress_bytes_qmk_lz(bytearray):
+    data = bytes(bytearray)
+    output = []
+    literals = []
+    chains = {}
+
+    def insert(pos):
+        key = data[pos:pos + QMK_LZ_MIN_MATCH]
+        if len(key) == QMK_LZ_MIN_MATCH:
+            chains.setdefault(key, deque(maxlen=QMK_LZ_CHAIN_LENGTH)).appendleft(pos)
+
+    pos = 0
+    while pos < len(data):
+        length, offset = _qmk_lz_find_match(data, pos, chains)
+
+        # Breaking up a literal run costs an extra token byte when it resumes
+        min_length = QMK_LZ_MIN_MATCH + (1 if literals else 0)
+
+        # Emit a literal instead if the next position gives a longer match
+        if length >= min_length and _qmk_lz_find_match(data, pos + 1, chains)[0] > length + 1:
+            length = 0
+
+        if length >= min_length:
+            _qmk_lz_append_literals(output, literals)
+            _qmk_lz_append_match(output, length, offset)
+            for n in range(pos, pos + length):
+                insert(n)
+            pos += length
+        else:
+            literals.append(data[pos])
+            insert(pos)
+            pos += 1
+
+    _qmk_lz_append_literals(output, literals)
+    return output
@@ -7,6 +7,88 @@
 #include "serial_protocol.h"
 #include "synchronization_util.h"
 
+#if defined(SPLIT_TRANSPORT_PIPELINED) && !defined(SPLIT_TRANSPORT_FRAMED)
+#    error "SPLIT_TRANSPORT_PIPELINED requires SPLIT_TRANSPORT_FRAMED"
+#endif
+
+#ifdef SPLIT_TRANSPORT_FRAMED
+#    include "crc.h"
+
+/* Sent in place of a transaction id to start a frame, which is followed by
+ * a count, the transaction ids and a crc8 over the count and one (id,
+ * initiator2target length, target2initiator length) entry per transaction.
+ * The lengths never go over the wire, each half checksums its own, so halves
+ * that disagree on one fail the header check. Each side closes its payloads
+ * with the XOR of their crc8s, and the slave only runs callbacks for payloads
+ * that arrived intact. */
+#    define SERIAL_FRAME_TRANSACTION_ID 0xFF
+#    define SERIAL_FRAME_HEADER_SIZE(count) (1 + (count) + 1)
+
+_Static_assert(NUM_TOTAL_TRANSACTIONS < SERIAL_FRAME_TRANSACTION_ID, "Frame marker collides with a transaction id");
+
+/* After a failure, the master waits for the link to stay quiet this long
+ * before starting over. It needs to cover a couple of byte times, so raise it
+ * for speeds below 57600 baud. */
+#    ifndef SERIAL_FRAME_RESYNC_IDLE_US
+#        define SERIAL_FRAME_RESYNC_IDLE_US 200
+#    endif
+
+/* A link that never goes quiet, like a floating RX line, fails the transaction
+ * after waiting this long, and the next one tries again. */
+#    ifndef SERIAL_FRAME_RESYNC_MAX_US
+#        define SERIAL_FRAME_RESYNC_MAX_US 2000
+#    endif
+
+/* Set after a failure, on either half, until the link is back in step. */
+static bool frame_resync = false;
+
+static inline bool drain_link(void);
+
+#    ifdef SPLIT_TRANSPORT_PIPELINED
+#        ifndef SERIAL_USART_FULL_DUPLEX
+#            error "SPLIT_TRANSPORT_PIPELINED requires SERIAL_USART_FULL_DUPLEX"
+#        endif
+
+/* With both directions on their own wire, the master streams the header and
+ * all payloads without waiting for the slave. The slave answers every
+ * transaction as soon as its callback ran, so the driver transmits one
+ * response while the next callback is running.
+ *
+ * After any failure, the rest of a streamed frame may still be arriving, and
+ * its payload bytes could pass for transaction ids. Both halves therefore
+ * resynchronise on a frame: the slave skips everything up to the next frame
+ * marker, and the master sends its next transaction as a frame, even if it is
+ * a lone one. Frames are checksummed before any callback runs, so stray bytes
+ * never reach one. */
+#    endif // SPLIT_TRANSPORT_PIPELINED
+
+static inline uint8_t frame_header_checksum(const uint8_t* transaction_ids, uint8_t count);
+static inline bool    receive_frame_checksum(uint8_t checksum);
+static inline bool    initiate_frame(const uint8_t* transaction_ids, uint8_t count);
+static inline bool    react_to_frame(void);
+#endif // SPLIT_TRANSPORT_FRAMED
+
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+#    ifndef SERIAL_USART_FULL_DUPLEX
+#        error "SPLIT_MATRIX_NOTIFY_ENABLE requires SERIAL_USART_FULL_DUPLEX"
+#    endif
+#    include "crc.h"
+
+/* Sent by the slave, unsolicited, in front of a notification: transaction id,
+ * payload length, payload and the XOR of the crc8s of header and payload. */
+#    define SERIAL_NOTIFY_TRANSACTION_ID 0xFE
+
+_Static_assert(NUM_TOTAL_TRANSACTIONS < SERIAL_NOTIFY_TRANSACTION_ID, "Notification marker collides with a transaction id");
+
+static uint32_t notifications_pending  = 0;
+static bool     notifications_dropped  = false;
+static uint16_t notifications_rejected = 0;
+
+static inline bool receive_notification(void);
+static inline void drain_notifications(void);
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
+static inline bool receive_handshake(uint8_t* handshake);
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
@@ -24,6 +106,9 @@ static THD_FUNCTION(SlaveThread, arg) {
             /* Clear the receive queue, to start with a clean slate.
              * Parts of failed transactions or spurious bytes could still be in it. */
             serial_transport_driver_clear();
+#ifdef SPLIT_TRANSPORT_PIPELINED
+            frame_resync = true;
+#endif // SPLIT_TRANSPORT_PIPELINED
         }
     }
 }
@@ -55,6 +140,23 @@ static inline bool react_to_transaction(void) {
         return false;
     }
 
+#ifdef SPLIT_TRANSPORT_PIPELINED
+    /* Skip what is left of a failed frame, bytes still arriving after the
+     * queue was cleared included. */
+    if (unlikely(frame_resync)) {
+        if (transaction_id != SERIAL_FRAME_TRANSACTION_ID) {
+            return true;
+        }
+        frame_resync = false;
+    }
+#endif // SPLIT_TRANSPORT_PIPELINED
+
+#ifdef SPLIT_TRANSPORT_FRAMED
+    if (transaction_id == SERIAL_FRAME_TRANSACTION_ID) {
+        return react_to_frame();
+    }
+#endif // SPLIT_TRANSPORT_FRAMED
+
     /* Sanity check that we are actually responding to a valid transaction. */
     if (unlikely(transaction_id >= NUM_TOTAL_TRANSACTIONS)) {
         return false;
@@ -100,11 +202,53 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+    /* Pick up notifications before they are thrown away with the rest. */
+    drain_notifications();
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
+#ifdef SPLIT_TRANSPORT_FRAMED
+    if (unlikely(frame_resync && !drain_link())) {
+        return false;
+    }
+#endif // SPLIT_TRANSPORT_FRAMED
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
 
+#if defined(SPLIT_TRANSPORT_PIPELINED)
+    uint8_t transaction_id = (uint8_t)index;
+    bool    okay           = frame_resync ? initiate_frame(&transaction_id, 1) : initiate_transaction(transaction_id);
+    frame_resync           = !okay;
+    return okay;
+#elif defined(SPLIT_TRANSPORT_FRAMED)
+    bool okay    = initiate_transaction((uint8_t)index);
+    frame_resync = !okay;
+    return okay;
+#else
     return initiate_transaction((uint8_t)index);
+#endif
+}
+
+/**
+ * @brief Receive the slaves handshake byte. With notifications enabled, the
+ * slave may squeeze one in right before it, which is consumed on the way.
+ */
+static inline bool receive_handshake(uint8_t* handshake) {
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+    while (serial_transport_receive(handshake, sizeof(*handshake))) {
+        if (*handshake != SERIAL_NOTIFY_TRANSACTION_ID) {
+            return true;
+        }
+        if (unlikely(!receive_notification())) {
+            return false;
+        }
+    }
+    return false;
+#else
+    return serial_transport_receive(handshake, sizeof(*handshake));
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
 }
 
 /**
@@ -133,7 +277,7 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
      *   - due to the half duplex limitations on return codes, we always have to read *something*.
      *   - without the read, write only transactions *always* succeed, even during the boot process where the slave is not ready.
      */
-    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)) || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
+    if (unlikely(!receive_handshake(&transaction_id_shake) || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
         serial_dprintf("SPLIT: receiving handshake failed\n");
         return false;
     }
@@ -156,3 +300,367 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     return true;
 }
+
+#ifdef SPLIT_TRANSPORT_FRAMED
+
+/**
+ * @brief React to a frame of transactions started by the master.
+ */
+static inline bool react_to_frame(void) {
+    uint8_t header[SERIAL_FRAME_HEADER_SIZE(NUM_TOTAL_TRANSACTIONS)];
+
+    if (unlikely(!serial_transport_receive(&header[0], 1))) {
+        return false;
+    }
+
+    uint8_t count = header[0];
+    if (unlikely(count == 0 || count > NUM_TOTAL_TRANSACTIONS)) {
+        return false;
+    }
+
+    if (unlikely(!serial_transport_receive(&header[1], SERIAL_FRAME_HEADER_SIZE(count) - 1))) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (unlikely(header[1 + i] >= NUM_TOTAL_TRANSACTIONS)) {
+            return false;
+        }
+    }
+
+    /* Both halves have to agree on every payload length, or the streams below
+     * would get out of step. */
+    uint8_t checksum = frame_header_checksum(&header[1], count);
+    if (unlikely(checksum != header[SERIAL_FRAME_HEADER_SIZE(count) - 1])) {
+        return false;
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    uint8_t frame_shake = SERIAL_FRAME_TRANSACTION_ID ^ NUM_TOTAL_TRANSACTIONS;
+#    ifndef SPLIT_TRANSPORT_PIPELINED
+    /* A single handshake for the whole frame. */
+    if (unlikely(!serial_transport_send(&frame_shake, sizeof(frame_shake)))) {
+        return false;
+    }
+#    endif // SPLIT_TRANSPORT_PIPELINED
+
+    /* Receive all transaction buffers from the master in one go. */
+    checksum = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[header[1 + i]];
+        if (transaction->initiator2target_buffer_size) {
+            if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+                return false;
+            }
+            checksum ^= crc8(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size);
+        }
+    }
+
+    if (unlikely(!receive_frame_checksum(checksum))) {
+        return false;
+    }
+
+#    ifdef SPLIT_TRANSPORT_PIPELINED
+    /* Only acknowledge a frame that arrived intact, the master times out otherwise. */
+    if (unlikely(!serial_transport_send(&frame_shake, sizeof(frame_shake)))) {
+        return false;
+    }
+
+    checksum = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[header[1 + i]];
+        if (transaction->slave_callback) {
+            transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->target2initiator_buffer_size, split_trans_target2initiator_buffer(transaction));
+        }
+        if (transaction->target2initiator_buffer_size) {
+            if (unlikely(!serial_transport_send(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+                return false;
+            }
+            checksum ^= crc8(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size);
+        }
+    }
+
+    return serial_transport_send(&checksum, sizeof(checksum));
+#    else
+    /* Allow any slave processing to occur, in the order the master queued it. */
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[header[1 + i]];
+        if (transaction->slave_callback) {
+            transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->target2initiator_buffer_size, split_trans_target2initiator_buffer(transaction));
+        }
+    }
+
+    /* Answer with all transaction buffers the master asked for. */
+    checksum = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[header[1 + i]];
+        if (transaction->target2initiator_buffer_size) {
+            if (unlikely(!serial_transport_send(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+                return false;
+            }
+            checksum ^= crc8(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size);
+        }
+    }
+
+    return serial_transport_send(&checksum, sizeof(checksum));
+#    endif // SPLIT_TRANSPORT_PIPELINED
+}
+
+/**
+ * @brief Start a frame of transactions from the master half to the slave half.
+ *
+ * @param transaction_ids Transaction Table indices of the transactions to run, in order.
+ * @param count Number of transactions in the frame.
+ * @return bool Indicates success of the whole frame.
+ */
+bool soft_serial_transaction_frame(const uint8_t* transaction_ids, uint8_t count) {
+#    ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+    /* Pick up notifications before they are thrown away with the rest. */
+    drain_notifications();
+#    endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
+    if (unlikely(frame_resync && !drain_link())) {
+        return false;
+    }
+
+    /* Clear the receive queue, to start with a clean slate.
+     * Parts of failed transactions or spurious bytes could still be in it. */
+    serial_transport_driver_clear();
+
+    bool okay    = initiate_frame(transaction_ids, count);
+    frame_resync = !okay;
+    return okay;
+}
+
+/**
+ * @brief Initiate a frame of transactions to the slave half.
+ */
+static inline bool initiate_frame(const uint8_t* transaction_ids, uint8_t count) {
+    if (unlikely(count == 0 || count > NUM_TOTAL_TRANSACTIONS)) {
+        serial_dprintf("SPLIT: illegal frame size\n");
+        return false;
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    uint8_t header[1 + SERIAL_FRAME_HEADER_SIZE(NUM_TOTAL_TRANSACTIONS)];
+    header[0] = SERIAL_FRAME_TRANSACTION_ID;
+    header[1] = count;
+    for (uint8_t i = 0; i < count; i++) {
+        if (unlikely(transaction_ids[i] >= NUM_TOTAL_TRANSACTIONS)) {
+            serial_dprintf("SPLIT: illegal transaction id\n");
+            return false;
+        }
+        header[2 + i] = transaction_ids[i];
+    }
+    header[SERIAL_FRAME_HEADER_SIZE(count)] = frame_header_checksum(transaction_ids, count);
+
+    if (unlikely(!serial_transport_send(header, 1 + SERIAL_FRAME_HEADER_SIZE(count)))) {
+        serial_dprintf("SPLIT: sending frame header failed\n");
+        return false;
+    }
+
+    uint8_t frame_shake = 0;
+#    ifndef SPLIT_TRANSPORT_PIPELINED
+    if (unlikely(!receive_handshake(&frame_shake) || (frame_shake != (SERIAL_FRAME_TRANSACTION_ID ^ NUM_TOTAL_TRANSACTIONS)))) {
+        serial_dprintf("SPLIT: receiving frame handshake failed\n");
+        return false;
+    }
+#    endif // SPLIT_TRANSPORT_PIPELINED
+
+    /* Send all transaction buffers to the slave back to back. */
+    uint8_t checksum = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[i]];
+        if (transaction->initiator2target_buffer_size) {
+            if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+                serial_dprintf("SPLIT: sending frame buffer failed\n");
+                return false;
+            }
+            checksum ^= crc8(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size);
+        }
+    }
+
+    if (unlikely(!serial_transport_send(&checksum, sizeof(checksum)))) {
+        serial_dprintf("SPLIT: sending frame checksum failed\n");
+        return false;
+    }
+
+#    ifdef SPLIT_TRANSPORT_PIPELINED
+    if (unlikely(!receive_handshake(&frame_shake) || (frame_shake != (SERIAL_FRAME_TRANSACTION_ID ^ NUM_TOTAL_TRANSACTIONS)))) {
+        serial_dprintf("SPLIT: receiving frame handshake failed\n");
+        return false;
+    }
+#    endif // SPLIT_TRANSPORT_PIPELINED
+
+    /* Receive all transaction buffers from the slave back to back. */
+    checksum = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[i]];
+        if (transaction->target2initiator_buffer_size) {
+            if (unlikely(!serial_transport_receive(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+                serial_dprintf("SPLIT: receiving frame buffer failed\n");
+                return false;
+            }
+            checksum ^= crc8(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size);
+        }
+    }
+
+    if (unlikely(!receive_frame_checksum(checksum))) {
+        serial_dprintf("SPLIT: frame checksum mismatch\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Wait for the rest of a failed exchange to arrive and throw it away,
+ * so that the master doesn't take it for the start of the next one.
+ *
+ * @return bool Whether the link went quiet within SERIAL_FRAME_RESYNC_MAX_US.
+ */
+static inline bool drain_link(void) {
+    uint8_t byte;
+    for (uint32_t waited = 0; waited < (SERIAL_FRAME_RESYNC_MAX_US); waited += (SERIAL_FRAME_RESYNC_IDLE_US)) {
+        chThdSleepMicroseconds(SERIAL_FRAME_RESYNC_IDLE_US);
+        bool stale = false;
+        while (serial_transport_receive_nonblocking(&byte)) {
+            stale = true;
+        }
+#    ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+        /* A notification may have been among them. */
+        notifications_dropped |= stale;
+#    endif // SPLIT_MATRIX_NOTIFY_ENABLE
+        if (!stale) {
+            return true;
+        }
+    }
+    serial_dprintf("SPLIT: link didn't go quiet\n");
+    return false;
+}
+
+/**
+ * @brief Checksum a frame header the way it would look with both payload
+ * lengths next to every transaction id. The ids must be valid.
+ */
+static inline uint8_t frame_header_checksum(const uint8_t* transaction_ids, uint8_t count) {
+    uint8_t layout[1 + NUM_TOTAL_TRANSACTIONS * 3];
+    layout[0] = count;
+    for (uint8_t i = 0; i < count; i++) {
+        split_transaction_desc_t* transaction = &split_transaction_table[transaction_ids[i]];
+
+        layout[1 + i * 3] = transaction_ids[i];
+        layout[2 + i * 3] = transaction->initiator2target_buffer_size;
+        layout[3 + i * 3] = transaction->target2initiator_buffer_size;
+    }
+    return crc8(layout, 1 + count * 3);
+}
+
+/**
+ * @brief Receive the checksum that closes one half of a frame and compare it.
+ */
+static inline bool receive_frame_checksum(uint8_t checksum) {
+    uint8_t received = 0;
+    return serial_transport_receive(&received, sizeof(received)) && received == checksum;
+}
+
+#endif // SPLIT_TRANSPORT_FRAMED
+
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+
+/**
+ * @brief Push the first length bytes of a transactions target2initiator
+ * buffer to the master, without waiting to be asked. The caller must hold
+ * the split shared memory lock, so this can't interleave with a transaction.
+ *
+ * @return bool Indicates that the notification was sent, not that it arrived.
+ */
+bool soft_serial_target_notify(int index, uint8_t length) {
+    if (unlikely(index < 0 || index >= NUM_TOTAL_TRANSACTIONS || !(SPLIT_NOTIFY_TRANSACTIONS & (1UL << index)))) {
+        return false;
+    }
+
+    split_transaction_desc_t* transaction = &split_transaction_table[index];
+    if (unlikely(length > transaction->target2initiator_buffer_size)) {
+        return false;
+    }
+
+    uint8_t header[3] = {SERIAL_NOTIFY_TRANSACTION_ID, (uint8_t)index, length};
+    uint8_t checksum  = crc8(&header[1], 2) ^ crc8(split_trans_target2initiator_buffer(transaction), length);
+
+    return serial_transport_send(header, sizeof(header)) && serial_transport_send(split_trans_target2initiator_buffer(transaction), length) && serial_transport_send(&checksum, sizeof(checksum));
+}
+
+/**
+ * @brief Collect the ids of all transactions whose target2initiator buffer
+ * was updated by a notification since the last call.
+ *
+ * @param dropped Set when a notification was received damaged, meaning the
+ * caller should fall back to asking the slave for the data.
+ * @return uint32_t Bitmask of transaction ids.
+ */
+uint32_t soft_serial_initiator_notifications(bool* dropped) {
+    drain_notifications();
+
+    uint32_t pending      = notifications_pending;
+    *dropped              = notifications_dropped;
+    notifications_pending = 0;
+    notifications_dropped = false;
+    return pending;
+}
+
+/**
+ * @brief Receive a notification on the master, after its marker byte. The
+ * caller must hold the split shared memory lock.
+ */
+static inline bool receive_notification(void) {
+    uint8_t header[2];
+    if (unlikely(!serial_transport_receive(header, sizeof(header)))) {
+        notifications_dropped = true;
+        return false;
+    }
+
+    /* Only a few transactions may notify, anything else is line noise or a
+     * slave with a different configuration. */
+    if (unlikely(header[0] >= NUM_TOTAL_TRANSACTIONS || !(SPLIT_NOTIFY_TRANSACTIONS & (1UL << header[0])))) {
+        notifications_rejected++;
+        serial_dprintf("SPLIT: rejected notification for id %u, %u so far\n", header[0], notifications_rejected);
+        notifications_dropped = true;
+        return false;
+    }
+
+    split_transaction_desc_t* transaction = &split_transaction_table[header[0]];
+    uint8_t                   checksum    = 0;
+    if (unlikely(header[1] > transaction->target2initiator_buffer_size || !serial_transport_receive(split_trans_target2initiator_buffer(transaction), header[1]) || !serial_transport_receive(&checksum, sizeof(checksum)))) {
+        notifications_dropped = true;
+        return false;
+    }
+
+    if (unlikely(checksum != (crc8(header, sizeof(header)) ^ crc8(split_trans_target2initiator_buffer(transaction), header[1])))) {
+        serial_dprintf("SPLIT: notification checksum mismatch\n");
+        notifications_dropped = true;
+        return false;
+    }
+
+    notifications_pending |= 1UL << header[0];
+    return true;
+}
+
+/**
+ * @brief Consume everything the slave pushed while the master was busy.
+ */
+static inline void drain_notifications(void) {
+    split_shared_memory_lock_autounlock();
+
+    uint8_t marker;
+    while (serial_transport_receive_nonblocking(&marker)) {
+        /* Anything else is left over from a failed transaction. */
+        if (marker == SERIAL_NOTIFY_TRANSACTION_ID) {
+            receive_notification();
+        }
+    }
+}
+
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
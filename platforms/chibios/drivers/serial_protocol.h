@@ -40,6 +40,14 @@ bool __attribute__((nonnull, hot)) serial_transport_receive(uint8_t* destination
  */
 bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* destination, const size_t size);
 
+/**
+ * @brief Receive a single byte, but only if one has already arrived.
+ *
+ * @return true Receive success.
+ * @return false Nothing to receive.
+ */
+bool __attribute__((nonnull)) serial_transport_receive_nonblocking(uint8_t* destination);
+
 /**
  * @brief Blocking send of buffer with timeout.
  *
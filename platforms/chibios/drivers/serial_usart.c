@@ -165,6 +165,10 @@ inline bool serial_transport_receive_blocking(uint8_t* destination, const size_t
     return success;
 }
 
+inline bool serial_transport_receive_nonblocking(uint8_t* destination) {
+    return chnReadTimeout(serial_driver, destination, 1, TIME_IMMEDIATE) == 1;
+}
+
 #if !defined(SERIAL_USART_FULL_DUPLEX)
 
 /**
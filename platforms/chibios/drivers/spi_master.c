@@ -60,6 +60,7 @@
 #endif
 
 static bool spiStarted = false;
+static bool spiSending = false;
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
 static pin_t current_slave_pin     = NO_PIN;
 static bool  current_cs_active_low = true;
@@ -67,6 +68,16 @@ static bool  current_cs_active_low = true;
 
 static SPIConfig spiConfig;
 
+// Signalled by the driver whenever a transfer completes; only waited on for spi_transmit_async()
+static BSEMAPHORE_DECL(spiTransferDone, true);
+
+static void spi_transfer_complete(SPIDriver *spip) {
+    (void)spip;
+    osalSysLockFromISR();
+    chBSemSignalI(&spiTransferDone);
+    osalSysUnlockFromISR();
+}
+
 static inline void spi_select(void) {
     spiSelect(&SPI_DRIVER);
 
@@ -405,6 +416,7 @@ bool spi_start_extended(spi_start_config_t *start_config) {
 #    error "Unsupported SPI_SELECT_MODE"
 #endif
 
+    spiConfig.end_cb = spi_transfer_complete;
     spiStart(&SPI_DRIVER, &spiConfig);
     spi_select();
 
@@ -421,7 +433,17 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     return spi_start_extended(&start_config);
 }
 
+spi_status_t spi_transmit_wait(void) {
+    if (spiSending) {
+        chBSemWait(&spiTransferDone);
+        spiSending = false;
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_write(uint8_t data) {
+    spi_transmit_wait();
+
     uint8_t rxData;
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
@@ -429,6 +451,8 @@ spi_status_t spi_write(uint8_t data) {
 }
 
 spi_status_t spi_read(void) {
+    spi_transmit_wait();
+
     uint8_t data = 0;
     spiReceive(&SPI_DRIVER, 1, &data);
 
@@ -436,17 +460,32 @@ spi_status_t spi_read(void) {
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+
+    // Blocking transfers signal completion too, so clear that out before starting
+    chBSemReset(&spiTransferDone, true);
+    spiSending = true;
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 void spi_stop(void) {
     if (spiStarted) {
+        spi_transmit_wait();
         spi_unselect();
         spiStop(&SPI_DRIVER);
         spiStarted = false;
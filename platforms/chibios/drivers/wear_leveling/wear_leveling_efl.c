@@ -100,6 +100,20 @@ bool backing_store_init(void) {
 
 #endif // defined(WEAR_LEVELING_EFL_FIRST_SECTOR)
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // The second bank needs to start on a sector boundary so that each bank can be erased on its own
+    bool bank_aligned = false;
+    for (flash_sector_t i = 0; i < sector_count; ++i) {
+        if (flashGetSectorOffset(flash, first_sector + i) == base_offset + (WEAR_LEVELING_BANK_SIZE)) {
+            bank_aligned = true;
+            break;
+        }
+    }
+    if (!bank_aligned) {
+        chSysHalt("Wear-leveling banks are not aligned to flash sectors");
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     return true;
 }
 
@@ -133,6 +147,33 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_sector(uint32_t address, uint32_t *length) {
+    for (flash_sector_t i = 0; i < sector_count; ++i) {
+        if (flashGetSectorOffset(flash, first_sector + i) != base_offset + address) {
+            continue;
+        }
+
+        // Only kick off the sector erase, backing_store_erase_busy() checks on it
+        flash_error_t status = flashStartEraseSector(flash, first_sector + i);
+        *length              = flashGetSectorSize(flash, first_sector + i);
+        return status == FLASH_NO_ERROR || status == FLASH_BUSY_ERASING;
+    }
+
+    bs_dprintf("No sector starts at 0x%08lX\n", (unsigned long)address);
+    return false;
+}
+
+bool backing_store_erase_busy(void) {
+    uint32_t      wait_time;
+    flash_error_t status = flashQueryErase(flash, &wait_time);
+    if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+        bs_dprintf("Sector erase failed\n");
+    }
+    return status == FLASH_BUSY_ERASING;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
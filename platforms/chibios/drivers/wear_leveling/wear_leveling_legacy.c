@@ -36,6 +36,15 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+_Static_assert((WEAR_LEVELING_BANK_SIZE) % (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE) == 0, "Bank size must be a multiple of WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE");
+
+bool backing_store_erase_sector(uint32_t address, uint32_t* length) {
+    *length = (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE);
+    return FLASH_ErasePage((WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS) + address) == FLASH_COMPLETE;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = ((WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS) + address);
     bs_dprintf("Write ");
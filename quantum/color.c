@@ -108,3 +108,100 @@ rgb_t hsv_to_rgb(hsv_t hsv) {
 rgb_t hsv_to_rgb_nocie(hsv_t hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
+
+// clang-format off
+
+// Hue sector and position within it, precomputed from h * 6 / 255 and
+// (h * 2 - region * 85) * 3 to avoid the divide in batch conversions.
+static const uint8_t hue_region[256] PROGMEM = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,
+      3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   3,
+      3,   3,   3,   3,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,   4,
+      4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,
+      4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,   4,
+      4,   4,   4,   4,   4,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,
+      5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,
+      5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   5,   6,
+};
+
+static const uint8_t hue_remainder[256] PROGMEM = {
+      0,   6,  12,  18,  24,  30,  36,  42,  48,  54,  60,  66,  72,  78,  84,  90,
+     96, 102, 108, 114, 120, 126, 132, 138, 144, 150, 156, 162, 168, 174, 180, 186,
+    192, 198, 204, 210, 216, 222, 228, 234, 240, 246, 252,   3,   9,  15,  21,  27,
+     33,  39,  45,  51,  57,  63,  69,  75,  81,  87,  93,  99, 105, 111, 117, 123,
+    129, 135, 141, 147, 153, 159, 165, 171, 177, 183, 189, 195, 201, 207, 213, 219,
+    225, 231, 237, 243, 249,   0,   6,  12,  18,  24,  30,  36,  42,  48,  54,  60,
+     66,  72,  78,  84,  90,  96, 102, 108, 114, 120, 126, 132, 138, 144, 150, 156,
+    162, 168, 174, 180, 186, 192, 198, 204, 210, 216, 222, 228, 234, 240, 246, 252,
+      3,   9,  15,  21,  27,  33,  39,  45,  51,  57,  63,  69,  75,  81,  87,  93,
+     99, 105, 111, 117, 123, 129, 135, 141, 147, 153, 159, 165, 171, 177, 183, 189,
+    195, 201, 207, 213, 219, 225, 231, 237, 243, 249,   0,   6,  12,  18,  24,  30,
+     36,  42,  48,  54,  60,  66,  72,  78,  84,  90,  96, 102, 108, 114, 120, 126,
+    132, 138, 144, 150, 156, 162, 168, 174, 180, 186, 192, 198, 204, 210, 216, 222,
+    228, 234, 240, 246, 252,   3,   9,  15,  21,  27,  33,  39,  45,  51,  57,  63,
+     69,  75,  81,  87,  93,  99, 105, 111, 117, 123, 129, 135, 141, 147, 153, 159,
+    165, 171, 177, 183, 189, 195, 201, 207, 213, 219, 225, 231, 237, 243, 249,   0,
+};
+
+// clang-format on
+
+static void hsv_to_rgb_batch_impl(const hsv_t *hsv, rgb_t *rgb, uint16_t count, bool use_cie) {
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t v = hsv[i].v;
+#ifdef USE_CIE1931_CURVE
+        if (use_cie) {
+            v = pgm_read_byte(&CIE1931_CURVE[v]);
+        }
+#endif
+
+        uint8_t s = hsv[i].s;
+        if (s == 0) {
+            rgb[i].r = rgb[i].g = rgb[i].b = v;
+            continue;
+        }
+
+        uint8_t h         = hsv[i].h;
+        uint8_t remainder = pgm_read_byte(&hue_remainder[h]);
+        uint8_t p         = (v * (255 - s)) >> 8;
+        uint8_t q         = (v * (255 - ((s * remainder) >> 8))) >> 8;
+        uint8_t t         = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+        switch (pgm_read_byte(&hue_region[h])) {
+            case 6:
+            case 0:
+                rgb[i] = (rgb_t){.r = v, .g = t, .b = p};
+                break;
+            case 1:
+                rgb[i] = (rgb_t){.r = q, .g = v, .b = p};
+                break;
+            case 2:
+                rgb[i] = (rgb_t){.r = p, .g = v, .b = t};
+                break;
+            case 3:
+                rgb[i] = (rgb_t){.r = p, .g = q, .b = v};
+                break;
+            case 4:
+                rgb[i] = (rgb_t){.r = t, .g = p, .b = v};
+                break;
+            default:
+                rgb[i] = (rgb_t){.r = v, .g = p, .b = q};
+                break;
+        }
+    }
+}
+
+void hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint16_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_batch_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+#endif
+}
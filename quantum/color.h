@@ -95,3 +95,6 @@ typedef hsv_t HSV;
 
 rgb_t hsv_to_rgb(hsv_t hsv);
 rgb_t hsv_to_rgb_nocie(hsv_t hsv);
+
+// Converts `count` values in one pass, with the same output as hsv_to_rgb()
+void hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint16_t count);
@@ -12,6 +12,44 @@
 #    include "haptic.h"
 #endif
 
+#if defined(EECONFIG_WRITE_BACK)
+#    include "timer.h"
+
+// Number of distinct regions held back at once, the cache is flushed to make room for another
+#    ifndef EECONFIG_WRITE_BACK_REGIONS
+#        define EECONFIG_WRITE_BACK_REGIONS 4
+#    endif
+
+// Largest update held back, anything bigger is written through
+#    ifndef EECONFIG_WRITE_BACK_MAX_SIZE
+#        define EECONFIG_WRITE_BACK_MAX_SIZE 8
+#    endif
+
+// Milliseconds without further updates before the cache is flushed
+#    ifndef EECONFIG_WRITE_BACK_TIMEOUT
+#        define EECONFIG_WRITE_BACK_TIMEOUT 2000
+#    endif
+
+_Static_assert(EECONFIG_WRITE_BACK_REGIONS > 0 && EECONFIG_WRITE_BACK_REGIONS <= 255, "EECONFIG_WRITE_BACK_REGIONS must be between 1 and 255");
+_Static_assert(EECONFIG_WRITE_BACK_MAX_SIZE > 0 && EECONFIG_WRITE_BACK_MAX_SIZE <= 255, "EECONFIG_WRITE_BACK_MAX_SIZE must be between 1 and 255");
+_Static_assert(EECONFIG_WRITE_BACK_TIMEOUT <= UINT16_MAX, "EECONFIG_WRITE_BACK_TIMEOUT must fit in a 16-bit timer");
+
+typedef struct {
+    uintptr_t address;
+    uint8_t   length;
+    uint8_t   data[EECONFIG_WRITE_BACK_MAX_SIZE];
+} eeconfig_write_back_region_t;
+
+// Pending updates, which never overlap each other
+static eeconfig_write_back_region_t write_back_regions[EECONFIG_WRITE_BACK_REGIONS];
+static uint8_t                      write_back_count = 0;
+static uint16_t                     write_back_timer = 0;
+
+static inline bool eeconfig_write_back_overlaps(const eeconfig_write_back_region_t *region, uintptr_t address, size_t len) {
+    return region->address < address + len && address < region->address + region->length;
+}
+#endif // defined(EECONFIG_WRITE_BACK)
+
 #if defined(VIA_ENABLE)
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
@@ -20,6 +58,121 @@ void eeconfig_init_via(void);
 
 _Static_assert((intptr_t)EECONFIG_HANDEDNESS == 14, "EEPROM handedness offset is incorrect");
 
+/** \brief eeconfig read block
+ *
+ * Reads eeconfig-owned EEPROM, including any updates still held in the write-back cache.
+ */
+void eeconfig_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_read_block(buf, addr, len);
+#if defined(EECONFIG_WRITE_BACK)
+    uintptr_t address = (uintptr_t)addr;
+    for (uint8_t i = 0; i < write_back_count; ++i) {
+        const eeconfig_write_back_region_t *region = &write_back_regions[i];
+        if (eeconfig_write_back_overlaps(region, address, len)) {
+            uintptr_t start = MAX(region->address, address);
+            uintptr_t end   = MIN(region->address + region->length, address + len);
+            memcpy((uint8_t *)buf + (start - address), &region->data[start - region->address], end - start);
+        }
+    }
+#endif
+}
+
+/** \brief eeconfig update block
+ *
+ * Updates eeconfig-owned EEPROM. With EECONFIG_WRITE_BACK, small updates are held back so that repeated updates to
+ * the same region are written out once the keyboard has been idle for EECONFIG_WRITE_BACK_TIMEOUT.
+ */
+void eeconfig_update_block(const void *buf, void *addr, size_t len) {
+#if defined(EECONFIG_WRITE_BACK)
+    uintptr_t address = (uintptr_t)addr;
+    for (uint8_t i = 0; i < write_back_count; ++i) {
+        eeconfig_write_back_region_t *region = &write_back_regions[i];
+        if (region->address == address && region->length == len) {
+            memcpy(region->data, buf, len);
+            write_back_timer = timer_read();
+            return;
+        }
+        if (eeconfig_write_back_overlaps(region, address, len)) {
+            // Partial overlaps keep their ordering by writing out everything held so far
+            eeconfig_flush();
+            break;
+        }
+    }
+
+    if (len <= EECONFIG_WRITE_BACK_MAX_SIZE) {
+        uint8_t current[EECONFIG_WRITE_BACK_MAX_SIZE];
+        eeprom_read_block(current, addr, len);
+        if (memcmp(current, buf, len) == 0) {
+            return;
+        }
+        if (write_back_count == EECONFIG_WRITE_BACK_REGIONS) {
+            eeconfig_flush();
+        }
+
+        eeconfig_write_back_region_t *region = &write_back_regions[write_back_count++];
+        region->address                      = address;
+        region->length                       = len;
+        memcpy(region->data, buf, len);
+        write_back_timer = timer_read();
+        return;
+    }
+#endif
+    eeprom_update_block(buf, addr, len);
+}
+
+/** \brief eeconfig flush
+ *
+ * Writes out all updates held in the write-back cache, such as before suspend or jumping to the bootloader.
+ */
+void eeconfig_flush(void) {
+#if defined(EECONFIG_WRITE_BACK)
+    if (write_back_count == 0) {
+        return;
+    }
+
+#    if defined(EEPROM_DRIVER)
+    eeprom_driver_begin_transaction();
+#    endif
+    for (uint8_t i = 0; i < write_back_count; ++i) {
+        eeprom_update_block(write_back_regions[i].data, (void *)write_back_regions[i].address, write_back_regions[i].length);
+    }
+    write_back_count = 0;
+#    if defined(EEPROM_DRIVER)
+    eeprom_driver_commit_transaction();
+#    endif
+#endif
+}
+
+/** \brief eeconfig task
+ *
+ * Flushes the write-back cache once no updates have been made for EECONFIG_WRITE_BACK_TIMEOUT.
+ */
+void eeconfig_task(void) {
+#if defined(EECONFIG_WRITE_BACK)
+    if (write_back_count > 0 && timer_elapsed(write_back_timer) >= (EECONFIG_WRITE_BACK_TIMEOUT)) {
+        eeconfig_flush();
+    }
+#endif
+}
+
+static uint8_t eeconfig_read_cached_byte(const uint8_t *addr) {
+    uint8_t val = 0;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+static uint16_t eeconfig_read_cached_word(const uint16_t *addr) {
+    uint16_t val = 0;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+static uint32_t eeconfig_read_cached_dword(const uint32_t *addr) {
+    uint32_t val = 0;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
 /** \brief eeconfig enable
  *
  * FIXME: needs doc
@@ -44,8 +197,13 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
  * FIXME: needs doc
  */
 void eeconfig_init_quantum(void) {
+#if defined(EECONFIG_WRITE_BACK)
+    // Anything held back predates the reset
+    write_back_count = 0;
+#endif
 #if defined(EEPROM_DRIVER)
     eeprom_driver_format(false);
+    eeprom_driver_begin_transaction();
 #endif
 
     eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
@@ -83,6 +241,11 @@ void eeconfig_init_quantum(void) {
 #endif
 
     eeconfig_init_kb();
+
+    eeconfig_flush();
+#if defined(EEPROM_DRIVER)
+    eeprom_driver_commit_transaction();
+#endif
 }
 
 /** \brief eeconfig initialization
@@ -106,6 +269,9 @@ void eeconfig_enable(void) {
  * FIXME: needs doc
  */
 void eeconfig_disable(void) {
+#if defined(EECONFIG_WRITE_BACK)
+    write_back_count = 0;
+#endif
 #if defined(EEPROM_DRIVER)
     eeprom_driver_format(false);
 #endif
@@ -145,14 +311,14 @@ bool eeconfig_is_disabled(void) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_debug(void) {
-    return eeprom_read_byte(EECONFIG_DEBUG);
+    return eeconfig_read_cached_byte(EECONFIG_DEBUG);
 }
 /** \brief eeconfig update debug
  *
  * FIXME: needs doc
  */
 void eeconfig_update_debug(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEBUG, val);
+    eeconfig_update_block(&val, EECONFIG_DEBUG, sizeof(val));
 }
 
 /** \brief eeconfig read default layer
@@ -160,7 +326,7 @@ void eeconfig_update_debug(uint8_t val) {
  * FIXME: needs doc
  */
 layer_state_t eeconfig_read_default_layer(void) {
-    uint8_t val = eeprom_read_byte(EECONFIG_DEFAULT_LAYER);
+    uint8_t val = eeconfig_read_cached_byte(EECONFIG_DEFAULT_LAYER);
 
 #ifdef DEFAULT_LAYER_STATE_IS_VALUE_NOT_BITMASK
     // stored as a layer number, so convert back to bitmask
@@ -183,7 +349,7 @@ void eeconfig_update_default_layer(layer_state_t state) {
     uint8_t val = state;
 #endif
 
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, val);
+    eeconfig_update_block(&val, EECONFIG_DEFAULT_LAYER, sizeof(val));
 }
 
 /** \brief eeconfig read keymap
@@ -191,14 +357,14 @@ void eeconfig_update_default_layer(layer_state_t state) {
  * FIXME: needs doc
  */
 uint16_t eeconfig_read_keymap(void) {
-    return eeprom_read_word(EECONFIG_KEYMAP);
+    return eeconfig_read_cached_word(EECONFIG_KEYMAP);
 }
 /** \brief eeconfig update keymap
  *
  * FIXME: needs doc
  */
 void eeconfig_update_keymap(uint16_t val) {
-    eeprom_update_word(EECONFIG_KEYMAP, val);
+    eeconfig_update_block(&val, EECONFIG_KEYMAP, sizeof(val));
 }
 
 /** \brief eeconfig read audio
@@ -206,14 +372,14 @@ void eeconfig_update_keymap(uint16_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_audio(void) {
-    return eeprom_read_byte(EECONFIG_AUDIO);
+    return eeconfig_read_cached_byte(EECONFIG_AUDIO);
 }
 /** \brief eeconfig update audio
  *
  * FIXME: needs doc
  */
 void eeconfig_update_audio(uint8_t val) {
-    eeprom_update_byte(EECONFIG_AUDIO, val);
+    eeconfig_update_block(&val, EECONFIG_AUDIO, sizeof(val));
 }
 
 #if (EECONFIG_KB_DATA_SIZE) == 0
@@ -222,14 +388,14 @@ void eeconfig_update_audio(uint8_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_kb(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD);
+    return eeconfig_read_cached_dword(EECONFIG_KEYBOARD);
 }
 /** \brief eeconfig update kb
  *
  * FIXME: needs doc
  */
 void eeconfig_update_kb(uint32_t val) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, val);
+    eeconfig_update_block(&val, EECONFIG_KEYBOARD, sizeof(val));
 }
 #endif // (EECONFIG_KB_DATA_SIZE) == 0
 
@@ -239,14 +405,14 @@ void eeconfig_update_kb(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_user(void) {
-    return eeprom_read_dword(EECONFIG_USER);
+    return eeconfig_read_cached_dword(EECONFIG_USER);
 }
 /** \brief eeconfig update user
  *
  * FIXME: needs doc
  */
 void eeconfig_update_user(uint32_t val) {
-    eeprom_update_dword(EECONFIG_USER, val);
+    eeconfig_update_block(&val, EECONFIG_USER, sizeof(val));
 }
 #endif // (EECONFIG_USER_DATA_SIZE) == 0
 
@@ -255,14 +421,14 @@ void eeconfig_update_user(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_haptic(void) {
-    return eeprom_read_dword(EECONFIG_HAPTIC);
+    return eeconfig_read_cached_dword(EECONFIG_HAPTIC);
 }
 /** \brief eeconfig update haptic
  *
  * FIXME: needs doc
  */
 void eeconfig_update_haptic(uint32_t val) {
-    eeprom_update_dword(EECONFIG_HAPTIC, val);
+    eeconfig_update_block(&val, EECONFIG_HAPTIC, sizeof(val));
 }
 
 /** \brief eeconfig read split handedness
@@ -270,14 +436,15 @@ void eeconfig_update_haptic(uint32_t val) {
  * FIXME: needs doc
  */
 bool eeconfig_read_handedness(void) {
-    return !!eeprom_read_byte(EECONFIG_HANDEDNESS);
+    return !!eeconfig_read_cached_byte(EECONFIG_HANDEDNESS);
 }
 /** \brief eeconfig update split handedness
  *
  * FIXME: needs doc
  */
 void eeconfig_update_handedness(bool val) {
-    eeprom_update_byte(EECONFIG_HANDEDNESS, !!val);
+    uint8_t handedness = !!val;
+    eeconfig_update_block(&handedness, EECONFIG_HANDEDNESS, sizeof(handedness));
 }
 
 #if (EECONFIG_KB_DATA_SIZE) > 0
@@ -304,8 +471,14 @@ void eeconfig_read_kb_datablock(void *data) {
  * FIXME: needs doc
  */
 void eeconfig_update_kb_datablock(const void *data) {
+#if defined(EEPROM_DRIVER)
+    eeprom_driver_begin_transaction();
+#endif
     eeprom_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
     eeprom_update_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
+#if defined(EEPROM_DRIVER)
+    eeprom_driver_commit_transaction();
+#endif
 }
 /** \brief eeconfig init keyboard data block
  *
@@ -341,8 +514,14 @@ void eeconfig_read_user_datablock(void *data) {
  * FIXME: needs doc
  */
 void eeconfig_update_user_datablock(const void *data) {
+#if defined(EEPROM_DRIVER)
+    eeprom_driver_begin_transaction();
+#endif
     eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
     eeprom_update_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
+#if defined(EEPROM_DRIVER)
+    eeprom_driver_commit_transaction();
+#endif
 }
 /** \brief eeconfig init user data block
  *
@@ -56,6 +56,33 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the number of rendered glyphs kept in RAM, so that text redrawn with the same font and colors
+ *      skips decoding. The least recently used glyph is replaced when full. Each entry requires
+ *      \ref QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE bytes of RAM. Defaults to 0, disabling the cache. Needs to be at
+ *      least 2 with \ref QUANTUM_PAINTER_ASYNC_PIXDATA, as the glyph still being sent is never replaced.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 0
+#endif
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+/**
+ * @def This controls the maximum size of a cached glyph, in bytes of the display's native pixel format. Larger
+ *      glyphs are always decoded. For example, a 16x16 glyph on an RGB565 display requires 512 bytes.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE 512
+#endif
+
+#ifndef QUANTUM_PAINTER_PALETTE_CACHE_ENTRIES
+/**
+ * @def This controls the number of recolored palettes kept in RAM after being converted to a display's native pixel
+ *      format, so that redrawing images and text with the same colors skips the conversion. Only palettes of up to
+ *      16 colors are cached. Each entry requires approximately 80 bytes of RAM. Set to 0 to disable the cache.
+ */
+#    define QUANTUM_PAINTER_PALETTE_CACHE_ENTRIES 4
+#endif
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -72,6 +99,23 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_ASYNC_PIXDATA
+/**
+ * @def This controls whether pixel data is sent to displays without waiting for each transmission to complete, so
+ *      that the next block can be decoded in the meantime. Requires a second pixel data buffer, doubling the RAM used
+ *      by QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE. Only comms drivers capable of non-blocking transfers benefit.
+ */
+#    define QUANTUM_PAINTER_ASYNC_PIXDATA FALSE
+#endif
+
+#ifndef QUANTUM_PAINTER_DECODE_BLOCK_SIZE
+/**
+ * @def This controls the number of pixels decoded from images at a time. Decoding in blocks allows runs to be expanded
+ *      and palette lookups to be made over whole spans, at the cost of stack space. Must be a multiple of 8.
+ */
+#    define QUANTUM_PAINTER_DECODE_BLOCK_SIZE 64
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -88,6 +132,14 @@
 #    define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_SUPPORTS_LZ_COMPRESSION
+/**
+ * @def This controls whether images compressed with QMK LZ are supported. Decoding requires a 1kB window of previously
+ *      decoded data to be kept in RAM.
+ */
+#    define QUANTUM_PAINTER_SUPPORTS_LZ_COMPRESSION FALSE
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter types
 
@@ -353,6 +405,20 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
  */
 painter_image_handle_t qp_load_image_mem(const void *buffer);
 
+#ifdef FLASH_ENABLE
+/**
+ * Loads an image stored in external flash, streaming its data from the flash whenever it's drawn.
+ *
+ * @note Images can be unloaded by calling \ref qp_close_image.
+ *
+ * @param address[in] the flash address of the image data
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if loading the image failed
+ */
+painter_image_handle_t qp_load_image_flash(uint32_t address);
+#endif // FLASH_ENABLE
+
 /**
  * Closes an image handle when no longer in use.
  *
@@ -440,6 +506,19 @@ void qp_stop_animation(deferred_token anim_token);
  */
 painter_font_handle_t qp_load_font_mem(const void *buffer);
 
+#ifdef FLASH_ENABLE
+/**
+ * Loads a font stored in external flash, streaming its data from the flash whenever it's drawn.
+ *
+ * @note Fonts can be unloaded by calling \ref qp_close_font.
+ *
+ * @param address[in] the flash address of the font data
+ * @return an image handle usable with \ref qp_textwidth, \ref qp_drawtext, and \ref qp_drawtext_recolor.
+ * @return NULL if loading the font failed
+ */
+painter_font_handle_t qp_load_font_flash(uint32_t address);
+#endif // FLASH_ENABLE
+
 /**
  * Closes a font handle when no longer in use.
  *
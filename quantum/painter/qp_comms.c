@@ -46,6 +46,23 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+// The data must be left untouched until the next send, or until comms are stopped
+uint32_t qp_comms_send_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_comms_send_async: fail (validation_ok == false)\n");
+        return false;
+    }
+
+#if QUANTUM_PAINTER_ASYNC_PIXDATA
+    if (driver->comms_vtable->comms_send_async) {
+        return driver->comms_vtable->comms_send_async(device, data, byte_count);
+    }
+#endif // QUANTUM_PAINTER_ASYNC_PIXDATA
+
+    return driver->comms_vtable->comms_send(device, data, byte_count);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
@@ -10,8 +10,18 @@
 // Quantum Painter utility functions
 
 // Global variable used for native pixel data streaming.
+#if QUANTUM_PAINTER_ASYNC_PIXDATA
+extern uint8_t *qp_internal_global_pixdata_buffer;
+
+// Switches to the other pixdata buffer, so it can be refilled while the last one is still being sent. Needs calling
+// after sending the buffer if its contents are going to be replaced.
+void qp_internal_swap_pixdata_buffer(void);
+#else
 extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
 
+static inline void qp_internal_swap_pixdata_buffer(void) {}
+#endif // QUANTUM_PAINTER_ASYNC_PIXDATA
+
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
 
@@ -36,6 +46,12 @@ bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count,
 bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg);
 bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg);
 
+// Block-oriented equivalents of the above, moving whole spans of bytes/pixels per callback invocation
+typedef int16_t (*qp_internal_block_input_callback)(void* cb_arg, uint8_t* buffer, uint16_t max_bytes);
+typedef bool (*qp_internal_pixel_block_output_callback)(qp_pixel_t* palette, uint8_t* indices, uint32_t count, void* cb_arg);
+bool qp_internal_decode_palette_block(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_block_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_block_output_callback output_callback, void* output_arg);
+bool qp_internal_send_bytes_block(painter_device_t device, uint32_t byte_count, qp_internal_block_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg);
+
 // Global variable used for interpolated pixel lookup table.
 #if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 extern qp_pixel_t qp_internal_global_pixel_lookup_table[256];
@@ -44,11 +60,11 @@ extern qp_pixel_t qp_internal_global_pixel_lookup_table[16];
 #endif
 
 // Generates a color-interpolated lookup table based off the number of items, from foreground to background, for use with monochrome image rendering.
-// Returns true if a palette was created, false if the palette is reused.
-// As this uses a global, this may present a problem if using the same parameters but a different screen converts pixels -- use qp_internal_invalidate_palette() below to reset.
-bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps);
+// The lookup table is converted to the device's native pixel format, reusing a previously converted palette if the device, colors and steps match.
+// Returns false if the palette could not be converted.
+bool qp_internal_interpolate_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps);
 
-// Resets the global palette so that it can be regenerated. Only needed if the colors are identical, but a different display is used with a different internal pixel format.
+// Resets the global palette so that it can be regenerated. Needed whenever the lookup table is overwritten with something other than an interpolated palette.
 void qp_internal_invalidate_palette(void);
 
 // Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset. Expects the stream to be positioned at the start of the block header.
@@ -57,6 +73,9 @@ bool qp_internal_load_qgf_palette(qp_stream_t* stream, uint8_t bpp);
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter codec functions
 
+// Number of previously decoded bytes that QMK LZ matches can refer back to
+#define QP_LZ_WINDOW_SIZE 1024
+
 enum qp_internal_rle_mode_t {
     MARKER_BYTE,
     REPEATING_RUN,
@@ -73,6 +92,13 @@ typedef struct qp_internal_byte_input_state_t {
             enum qp_internal_rle_mode_t mode;
             uint8_t                     remain; // number of bytes remaining in the current mode
         } rle;
+        // LZ-specific
+        struct {
+            bool     is_match;   // whether the current sequence is copied from the window, or is literal
+            uint16_t remain;     // number of bytes remaining in the current sequence
+            uint16_t offset;     // distance back into the window of the current match
+            uint16_t window_pos; // write position within the window
+        } lz;
     };
 } qp_internal_byte_input_state_t;
 
@@ -83,6 +109,7 @@ typedef struct qp_internal_pixel_output_state_t {
 } qp_internal_pixel_output_state_t;
 
 bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg);
+bool qp_internal_pixel_block_appender(qp_pixel_t* palette, uint8_t* indices, uint32_t count, void* cb_arg);
 
 typedef struct qp_internal_byte_output_state_t {
     painter_device_t device;
@@ -98,3 +125,9 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state);
 
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
+
+// Block-oriented equivalent of qp_internal_appender, decoding QUANTUM_PAINTER_DECODE_BLOCK_SIZE pixels at a time
+bool qp_internal_block_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_block_input_callback input_callback, void* input_state);
+
+// Block-oriented equivalent of qp_internal_prepare_input_state. The input state must not be shared with a per-byte input callback.
+qp_internal_block_input_callback qp_internal_prepare_block_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
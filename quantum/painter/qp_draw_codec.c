@@ -2,6 +2,7 @@
 // Copyright 2023 Pablo Martinez (@elpekenin) <elpekenin@elpekenin.dev>
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string.h>
 #include "qp_internal.h"
 #include "qp_draw.h"
 #include "qp_comms.h"
@@ -55,12 +56,9 @@ bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count,
 }
 
 bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    painter_driver_t* driver = (painter_driver_t*)device;
-    int16_t           steps  = 1 << bits_per_pixel; // number of items we need to interpolate
-    if (qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, steps)) {
-        if (!driver->driver_vtable->palette_convert(device, steps, qp_internal_global_pixel_lookup_table)) {
-            return false;
-        }
+    int16_t steps = 1 << bits_per_pixel; // number of items we need to interpolate
+    if (!qp_internal_interpolate_palette(device, fg_hsv888, bg_hsv888, steps)) {
+        return false;
     }
 
     return qp_internal_decode_palette(device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_internal_global_pixel_lookup_table, output_callback, output_arg);
@@ -81,6 +79,80 @@ bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_int
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Block-oriented decoders
+
+_Static_assert((QUANTUM_PAINTER_DECODE_BLOCK_SIZE) > 0 && (QUANTUM_PAINTER_DECODE_BLOCK_SIZE) % 8 == 0 && (QUANTUM_PAINTER_DECODE_BLOCK_SIZE) <= 4096, "QUANTUM_PAINTER_DECODE_BLOCK_SIZE must be a multiple of 8, no larger than 4096");
+
+// Fills the buffer with exactly the requested number of bytes, however many invocations of the input callback it takes
+static bool qp_internal_read_block(qp_internal_block_input_callback input_callback, void* input_arg, uint8_t* buffer, uint16_t byte_count) {
+    while (byte_count > 0) {
+        int16_t count = input_callback(input_arg, buffer, byte_count);
+        if (count <= 0) {
+            return false;
+        }
+        buffer += count;
+        byte_count -= count;
+    }
+    return true;
+}
+
+bool qp_internal_decode_palette_block(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_block_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_block_output_callback output_callback, void* output_arg) {
+    const uint8_t pixel_bitmask    = (1 << bits_per_pixel) - 1;
+    const uint8_t pixels_per_byte  = 8 / bits_per_pixel;
+    uint32_t      remaining_pixels = pixel_count;
+    uint8_t       indices[QUANTUM_PAINTER_DECODE_BLOCK_SIZE];
+    uint8_t       packed[QUANTUM_PAINTER_DECODE_BLOCK_SIZE / 2];
+    while (remaining_pixels > 0) {
+        uint16_t loop_pixels = remaining_pixels < QUANTUM_PAINTER_DECODE_BLOCK_SIZE ? remaining_pixels : QUANTUM_PAINTER_DECODE_BLOCK_SIZE;
+        uint16_t byte_count  = (loop_pixels + pixels_per_byte - 1) / pixels_per_byte;
+        if (pixels_per_byte == 1) {
+            // One index per byte, no unpacking required
+            if (!qp_internal_read_block(input_callback, input_arg, indices, byte_count)) {
+                return false;
+            }
+        } else {
+            if (!qp_internal_read_block(input_callback, input_arg, packed, byte_count)) {
+                return false;
+            }
+
+            // Unpack the indices, least significant bits first -- the block size being a multiple of 8 means a partially-used byte only ever lands at the end of the buffer
+            uint8_t* index = indices;
+            for (uint16_t i = 0; i < byte_count; ++i) {
+                uint8_t byteval = packed[i];
+                for (uint8_t q = 0; q < pixels_per_byte; ++q) {
+                    *index++ = byteval & pixel_bitmask;
+                    byteval >>= bits_per_pixel;
+                }
+            }
+        }
+
+        if (!output_callback(palette, indices, loop_pixels, output_arg)) {
+            return false;
+        }
+        remaining_pixels -= loop_pixels;
+    }
+    return true;
+}
+
+bool qp_internal_send_bytes_block(painter_device_t device, uint32_t byte_count, qp_internal_block_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg) {
+    uint32_t remaining_bytes = byte_count;
+    uint8_t  block[QUANTUM_PAINTER_DECODE_BLOCK_SIZE];
+    while (remaining_bytes > 0) {
+        uint16_t loop_bytes = remaining_bytes < QUANTUM_PAINTER_DECODE_BLOCK_SIZE ? remaining_bytes : QUANTUM_PAINTER_DECODE_BLOCK_SIZE;
+        if (!qp_internal_read_block(input_callback, input_arg, block, loop_bytes)) {
+            return false;
+        }
+        for (uint16_t i = 0; i < loop_bytes; ++i) {
+            if (!output_callback(block[i], output_arg)) {
+                return false;
+            }
+        }
+        remaining_bytes -= loop_bytes;
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Progressive pull of bytes, push of pixels
 
@@ -126,6 +198,57 @@ static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     return c;
 }
 
+static int16_t qp_drawimage_block_uncompressed_decoder(void* cb_arg, uint8_t* buffer, uint16_t max_bytes) {
+    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
+    return (int16_t)qp_stream_read(buffer, 1, max_bytes, state->src_stream);
+}
+
+static int16_t qp_drawimage_block_rle_decoder(void* cb_arg, uint8_t* buffer, uint16_t max_bytes) {
+    qp_internal_byte_input_state_t* state   = (qp_internal_byte_input_state_t*)cb_arg;
+    uint16_t                        written = 0;
+
+    while (written < max_bytes) {
+        // Parse the marker byte, and for repeated runs the byte to repeat
+        if (state->rle.mode == MARKER_BYTE) {
+            int16_t c = qp_stream_get(state->src_stream);
+            if (c < 0) {
+                break;
+            }
+            if (c >= 128) {
+                state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
+                state->rle.remain = c - 127;
+            } else {
+                state->rle.mode   = REPEATING_RUN; // repeated run
+                state->rle.remain = c;
+                state->curr       = qp_stream_get(state->src_stream);
+                if (state->curr < 0) {
+                    break;
+                }
+            }
+        }
+
+        // Expand as much of the run as fits
+        uint16_t count = max_bytes - written;
+        if (count > state->rle.remain) {
+            count = state->rle.remain;
+        }
+        if (state->rle.mode == REPEATING_RUN) {
+            memset(&buffer[written], state->curr, count);
+        } else if (qp_stream_read(&buffer[written], 1, count, state->src_stream) != count) {
+            break;
+        }
+        written += count;
+
+        // Swap back to querying the marker byte mode once the run is exhausted
+        state->rle.remain -= count;
+        if (state->rle.remain == 0) {
+            state->rle.mode = MARKER_BYTE;
+        }
+    }
+
+    return written > 0 ? written : STREAM_EOF;
+}
+
 bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
     qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
     painter_driver_t*                 driver = (painter_driver_t*)state->device;
@@ -139,12 +262,43 @@ bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg
         if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
             return false;
         }
+        qp_internal_swap_pixdata_buffer();
         state->pixel_write_pos = 0;
     }
 
     return true;
 }
 
+bool qp_internal_pixel_block_appender(qp_pixel_t* palette, uint8_t* indices, uint32_t count, void* cb_arg) {
+    qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
+    painter_driver_t*                 driver = (painter_driver_t*)state->device;
+
+    while (count > 0) {
+        // Convert as many pixels as fit in the rest of the buffer in one go
+        uint32_t loop_pixels = state->max_pixels - state->pixel_write_pos;
+        if (loop_pixels > count) {
+            loop_pixels = count;
+        }
+        if (!driver->driver_vtable->append_pixels(state->device, qp_internal_global_pixdata_buffer, palette, state->pixel_write_pos, loop_pixels, indices)) {
+            return false;
+        }
+        state->pixel_write_pos += loop_pixels;
+        indices += loop_pixels;
+        count -= loop_pixels;
+
+        // If we've hit the transmit limit, send out the entire buffer and reset the write position
+        if (state->pixel_write_pos == state->max_pixels) {
+            if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
+                return false;
+            }
+            qp_internal_swap_pixdata_buffer();
+            state->pixel_write_pos = 0;
+        }
+    }
+
+    return true;
+}
+
 bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
     qp_internal_byte_output_state_t* state  = (qp_internal_byte_output_state_t*)cb_arg;
     painter_driver_t*                driver = (painter_driver_t*)state->device;
@@ -159,6 +313,7 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
         if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
             return false;
         }
+        qp_internal_swap_pixdata_buffer();
         state->byte_write_pos = 0;
     }
 
@@ -181,6 +336,7 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         // Any leftovers need transmission as well.
         if (ret && output_state.pixel_write_pos > 0) {
             ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+            qp_internal_swap_pixdata_buffer();
         }
     }
 
@@ -198,12 +354,148 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         // Any leftovers need transmission as well.
         if (ret && output_state.byte_write_pos > 0) {
             ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+            qp_internal_swap_pixdata_buffer();
+        }
+    }
+
+    return ret;
+}
+
+// Block-oriented equivalent of qp_internal_appender -- uses either (qp_internal_decode_palette_block + qp_internal_pixel_block_appender) or (qp_internal_send_bytes_block)
+bool qp_internal_block_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_block_input_callback input_callback, void* input_state) {
+    painter_driver_t* driver = (painter_driver_t*)device;
+
+    bool ret = false;
+
+    // Non-native pixel format
+    if (bpp <= 8) {
+        // Set up the output state
+        qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
+
+        // Decode the pixel data and stream to the display
+        ret = qp_internal_decode_palette_block(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_block_appender, &output_state);
+        // Any leftovers need transmission as well.
+        if (ret && output_state.pixel_write_pos > 0) {
+            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+            qp_internal_swap_pixdata_buffer();
+        }
+    }
+
+    // Native pixel format
+    else if (bpp != driver->native_bits_per_pixel) {
+        qp_dprintf("Asset's bpp (%d) doesn't match the target display's native_bits_per_pixel (%d)\n", bpp, driver->native_bits_per_pixel);
+        return false;
+    } else {
+        // Set up the output state
+        qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
+
+        // Stream the raw pixel data to the display
+        uint32_t byte_count = pixel_count * bpp / 8;
+        ret                 = qp_internal_send_bytes_block(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
+        // Any leftovers need transmission as well.
+        if (ret && output_state.byte_write_pos > 0) {
+            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+            qp_internal_swap_pixdata_buffer();
         }
     }
 
     return ret;
 }
 
+#if QUANTUM_PAINTER_SUPPORTS_LZ_COMPRESSION
+_Static_assert((QP_LZ_WINDOW_SIZE & (QP_LZ_WINDOW_SIZE - 1)) == 0, "QP_LZ_WINDOW_SIZE must be a power of 2");
+
+// Previously decoded data, which matches are copied from
+static uint8_t qp_internal_lz_window[QP_LZ_WINDOW_SIZE];
+
+static int16_t qp_drawimage_block_lz_decoder(void* cb_arg, uint8_t* buffer, uint16_t max_bytes) {
+    qp_internal_byte_input_state_t* state   = (qp_internal_byte_input_state_t*)cb_arg;
+    uint16_t                        written = 0;
+    uint16_t                        pos     = state->lz.window_pos;
+
+    while (written < max_bytes) {
+        // Parse the next token
+        if (state->lz.remain == 0) {
+            int16_t token = qp_stream_get(state->src_stream);
+            if (token < 0) {
+                break;
+            }
+            if (token < 0x80) {
+                state->lz.is_match = false; // literal run
+                state->lz.remain   = token + 1;
+            } else {
+                int16_t offset = qp_stream_get(state->src_stream);
+                if (offset < 0) {
+                    break;
+                }
+                state->lz.is_match = true; // match from the window
+                state->lz.offset   = (((token & 0x03) << 8) | offset) + 1;
+                state->lz.remain   = ((token >> 2) & 0x1F) + 3;
+
+                // Maximum encoded length means the length continues in subsequent bytes
+                if (((token >> 2) & 0x1F) == 0x1F) {
+                    int16_t extra;
+                    do {
+                        extra = qp_stream_get(state->src_stream);
+                        if (extra < 0) {
+                            state->lz.window_pos = pos;
+                            return STREAM_EOF;
+                        }
+                        state->lz.remain += extra;
+                    } while (extra == 0xFF);
+                }
+            }
+        }
+
+        uint16_t count = max_bytes - written;
+        if (count > state->lz.remain) {
+            count = state->lz.remain;
+        }
+        uint8_t* out = &buffer[written];
+        if (state->lz.is_match) {
+            // Copy forwards a byte at a time, as matches may overlap the data they produce -- split so that neither the
+            // source nor the destination wrap around the end of the window
+            for (uint16_t remain = count; remain > 0;) {
+                uint16_t src   = (pos - state->lz.offset) & (QP_LZ_WINDOW_SIZE - 1);
+                uint16_t chunk = remain;
+                if (chunk > QP_LZ_WINDOW_SIZE - src) {
+                    chunk = QP_LZ_WINDOW_SIZE - src;
+                }
+                if (chunk > QP_LZ_WINDOW_SIZE - pos) {
+                    chunk = QP_LZ_WINDOW_SIZE - pos;
+                }
+                for (uint16_t i = 0; i < chunk; ++i) {
+                    uint8_t c                      = qp_internal_lz_window[src + i];
+                    qp_internal_lz_window[pos + i] = c;
+                    out[i]                         = c;
+                }
+                out += chunk;
+                pos = (pos + chunk) & (QP_LZ_WINDOW_SIZE - 1);
+                remain -= chunk;
+            }
+        } else {
+            if (qp_stream_read(out, 1, count, state->src_stream) != count) {
+                break;
+            }
+
+            // Keep the window up to date, wrapping around if needed
+            uint16_t first = QP_LZ_WINDOW_SIZE - pos;
+            if (first > count) {
+                first = count;
+            }
+            memcpy(&qp_internal_lz_window[pos], out, first);
+            memcpy(qp_internal_lz_window, &out[first], count - first);
+            pos = (pos + count) & (QP_LZ_WINDOW_SIZE - 1);
+        }
+        written += count;
+        state->lz.remain -= count;
+    }
+
+    state->lz.window_pos = pos;
+    return written > 0 ? written : STREAM_EOF;
+}
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ_COMPRESSION
+
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
     switch (compression) {
         case IMAGE_UNCOMPRESSED:
@@ -216,3 +508,23 @@ qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte
             return NULL;
     }
 }
+
+qp_internal_block_input_callback qp_internal_prepare_block_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
+    switch (compression) {
+        case IMAGE_UNCOMPRESSED:
+            return qp_drawimage_block_uncompressed_decoder;
+        case IMAGE_COMPRESSED_RLE:
+            input_state->rle.mode   = MARKER_BYTE;
+            input_state->rle.remain = 0;
+            return qp_drawimage_block_rle_decoder;
+#if QUANTUM_PAINTER_SUPPORTS_LZ_COMPRESSION
+        case IMAGE_COMPRESSED_LZ:
+            input_state->lz.is_match   = false;
+            input_state->lz.remain     = 0;
+            input_state->lz.window_pos = 0;
+            return qp_drawimage_block_lz_decoder;
+#endif // QUANTUM_PAINTER_SUPPORTS_LZ_COMPRESSION
+        default:
+            return NULL;
+    }
+}
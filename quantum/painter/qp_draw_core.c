@@ -20,11 +20,18 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 //
 
 // Buffer used for transmitting native pixel data to the downstream device.
+#if QUANTUM_PAINTER_ASYNC_PIXDATA
+// One buffer is filled while the other is still being transmitted.
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+uint8_t                                       *qp_internal_global_pixdata_buffer = qp_internal_pixdata_buffers[0];
+#else
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif // QUANTUM_PAINTER_ASYNC_PIXDATA
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
 static int16_t                                    generated_steps   = -1;
+static painter_device_t                           generated_device  = NULL;
 __attribute__((__aligned__(4))) static qp_pixel_t interpolated_fg_hsv888;
 __attribute__((__aligned__(4))) static qp_pixel_t interpolated_bg_hsv888;
 #if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
@@ -41,6 +48,12 @@ uint32_t qp_internal_num_pixels_in_buffer(painter_device_t device) {
     return ((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 8) / driver->native_bits_per_pixel);
 }
 
+#if QUANTUM_PAINTER_ASYNC_PIXDATA
+void qp_internal_swap_pixdata_buffer(void) {
+    qp_internal_global_pixdata_buffer = (qp_internal_global_pixdata_buffer == qp_internal_pixdata_buffers[0]) ? qp_internal_pixdata_buffers[1] : qp_internal_pixdata_buffers[0];
+}
+#endif // QUANTUM_PAINTER_ASYNC_PIXDATA
+
 // qp_setpixel internal implementation, but accepts a buffer with pre-converted native pixel. Only the first pixel is used.
 bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y) {
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -64,26 +77,68 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
     }
 }
 
-// Resets the global palette so that it can be regenerated. Only needed if the colors are identical, but a different display is used with a different internal pixel format.
+#if QUANTUM_PAINTER_PALETTE_CACHE_ENTRIES > 0
+// Previously converted palettes, so that redrawing with the same colors skips interpolation and conversion
+typedef struct qp_palette_cache_entry_t {
+    painter_device_t device;
+    qp_pixel_t       fg_hsv888;
+    qp_pixel_t       bg_hsv888;
+    int16_t          steps; // 0 if unused
+    uint16_t         last_used;
+    qp_pixel_t       palette[16];
+} qp_palette_cache_entry_t;
+
+static qp_palette_cache_entry_t qp_palette_cache[QUANTUM_PAINTER_PALETTE_CACHE_ENTRIES];
+static uint16_t                 qp_palette_cache_clock = 0;
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_ENTRIES > 0
+
+static inline bool qp_internal_hsv888_equal(qp_pixel_t a, qp_pixel_t b) {
+    return a.hsv888.h == b.hsv888.h && a.hsv888.s == b.hsv888.s && a.hsv888.v == b.hsv888.v;
+}
+
+// Resets the global palette so that it can be regenerated. Needed whenever the lookup table is overwritten with something other than an interpolated palette.
 void qp_internal_invalidate_palette(void) {
     generated_palette = false;
     generated_steps   = -1;
+    generated_device  = NULL;
 }
 
-// Interpolates between two colors to generate a palette
-bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
-    // Check if we need to generate a new palette -- if the input parameters match then assume the palette can stay unchanged.
-    // This may present a problem if using the same parameters but a different screen converts pixels -- use qp_internal_invalidate_palette() to reset.
-    if (generated_palette == true && generated_steps == steps && memcmp(&interpolated_fg_hsv888, &fg_hsv888, sizeof(fg_hsv888)) == 0 && memcmp(&interpolated_bg_hsv888, &bg_hsv888, sizeof(bg_hsv888)) == 0) {
+// Interpolates between two colors to generate a palette, converted to the device's native pixel format
+bool qp_internal_interpolate_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    // Check if we need to generate a new palette -- if the input parameters match then the palette can stay unchanged.
+    if (generated_palette == true && generated_device == device && generated_steps == steps && qp_internal_hsv888_equal(interpolated_fg_hsv888, fg_hsv888) && qp_internal_hsv888_equal(interpolated_bg_hsv888, bg_hsv888)) {
         // We already have the correct palette, no point regenerating it.
-        return false;
+        return true;
     }
 
-    // Save the parameters so we know whether we can skip generation
-    generated_palette      = true;
-    generated_steps        = steps;
-    interpolated_fg_hsv888 = fg_hsv888;
-    interpolated_bg_hsv888 = bg_hsv888;
+#if QUANTUM_PAINTER_PALETTE_CACHE_ENTRIES > 0
+    // Check if the palette was converted previously, keeping track of the best slot to replace if not
+    qp_palette_cache_entry_t *victim = &qp_palette_cache[0];
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_PALETTE_CACHE_ENTRIES; ++i) {
+        qp_palette_cache_entry_t *entry = &qp_palette_cache[i];
+        if (entry->steps == 0) {
+            if (victim->steps != 0) {
+                victim = entry;
+            }
+            continue;
+        }
+        if (entry->device == device && entry->steps == steps && qp_internal_hsv888_equal(entry->fg_hsv888, fg_hsv888) && qp_internal_hsv888_equal(entry->bg_hsv888, bg_hsv888)) {
+            memcpy(qp_internal_global_pixel_lookup_table, entry->palette, steps * sizeof(qp_pixel_t));
+            entry->last_used       = ++qp_palette_cache_clock;
+            generated_palette      = true;
+            generated_steps        = steps;
+            generated_device       = device;
+            interpolated_fg_hsv888 = fg_hsv888;
+            interpolated_bg_hsv888 = bg_hsv888;
+            return true;
+        }
+        if (victim->steps != 0 && (uint16_t)(qp_palette_cache_clock - entry->last_used) > (uint16_t)(qp_palette_cache_clock - victim->last_used)) {
+            victim = entry;
+        }
+    }
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_ENTRIES > 0
 
     int16_t hue_fg = fg_hsv888.hsv888.h;
     int16_t hue_bg = bg_hsv888.hsv888.h;
@@ -104,6 +159,31 @@ bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888,
         qp_dprintf("qp_internal_interpolate_palette: %3d of %d -- H: %3d, S: %3d, V: %3d\n", (int)(i + 1), (int)steps, (int)qp_internal_global_pixel_lookup_table[i].hsv888.h, (int)qp_internal_global_pixel_lookup_table[i].hsv888.s, (int)qp_internal_global_pixel_lookup_table[i].hsv888.v);
     }
 
+    // Convert the palette to native format
+    if (!driver->driver_vtable->palette_convert(device, steps, qp_internal_global_pixel_lookup_table)) {
+        qp_internal_invalidate_palette();
+        return false;
+    }
+
+    // Save the parameters so we know whether we can skip generation
+    generated_palette      = true;
+    generated_steps        = steps;
+    generated_device       = device;
+    interpolated_fg_hsv888 = fg_hsv888;
+    interpolated_bg_hsv888 = bg_hsv888;
+
+#if QUANTUM_PAINTER_PALETTE_CACHE_ENTRIES > 0
+    // Only palettes up to 4bpp are kept, 8bpp palettes are too large to be worth caching
+    if (steps <= (int16_t)(sizeof(victim->palette) / sizeof(victim->palette[0]))) {
+        memcpy(victim->palette, qp_internal_global_pixel_lookup_table, steps * sizeof(qp_pixel_t));
+        victim->device    = device;
+        victim->fg_hsv888 = fg_hsv888;
+        victim->bg_hsv888 = bg_hsv888;
+        victim->steps     = steps;
+        victim->last_used = ++qp_palette_cache_clock;
+    }
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_ENTRIES > 0
+
     return true;
 }
 
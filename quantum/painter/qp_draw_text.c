@@ -27,6 +27,9 @@ typedef struct qff_font_handle_t {
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
+#ifdef FLASH_ENABLE
+        qp_flash_stream_t flash_stream;
+#endif // FLASH_ENABLE
     };
 #if QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
     bool  owns_buffer;
@@ -36,6 +39,98 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+#    if QUANTUM_PAINTER_ASYNC_PIXDATA
+// The glyph most recently sent to the display may still be in flight, so there always needs to be another to replace
+_Static_assert(QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES >= 2, "QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES needs to be 0, or at least 2 with QUANTUM_PAINTER_ASYNC_PIXDATA");
+#    endif // QUANTUM_PAINTER_ASYNC_PIXDATA
+_Static_assert((QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE % 4) == 0, "QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE needs to be a multiple of 4");
+
+typedef struct qp_glyph_cache_entry_t {
+    painter_device_t   device; // NULL if unused
+    qff_font_handle_t *font;
+    uint32_t           code_point;
+    qp_pixel_t         fg_hsv888;
+    qp_pixel_t         bg_hsv888;
+    uint32_t           last_used;
+    uint8_t            width;
+    __attribute__((__aligned__(4))) uint8_t pixdata[QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE];
+} qp_glyph_cache_entry_t;
+
+static qp_glyph_cache_entry_t glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES] = {0};
+static uint32_t               glyph_cache_clock                                = 0;
+static qp_glyph_cache_entry_t *glyph_cache_sending                              = NULL; // never replaced, may still be in flight
+
+// Finds a cached glyph -- a NULL device matches any device and colors, for when only the width is needed
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(painter_device_t device, qff_font_handle_t *qff_font, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (!entry->device || entry->font != qff_font || entry->code_point != code_point) {
+            continue;
+        }
+        if (device && (entry->device != device || entry->fg_hsv888.dummy != fg_hsv888.dummy || entry->bg_hsv888.dummy != bg_hsv888.dummy)) {
+            continue;
+        }
+        entry->last_used = ++glyph_cache_clock;
+        return entry;
+    }
+    return NULL;
+}
+
+// Picks an unused entry, or the least recently used one -- skipping the one which may still be in flight, as usage
+// order alone doesn't protect it from width lookups or font unloads
+static qp_glyph_cache_entry_t *qp_glyph_cache_evict(void) {
+    qp_glyph_cache_entry_t *oldest = NULL;
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry == glyph_cache_sending) {
+            continue;
+        }
+        if (!entry->device) {
+            return entry;
+        }
+        if (!oldest || (uint32_t)(glyph_cache_clock - entry->last_used) > (uint32_t)(glyph_cache_clock - oldest->last_used)) {
+            oldest = entry;
+        }
+    }
+    oldest->device = NULL;
+    return oldest;
+}
+
+// Sends a cached glyph's pixel data to the display
+static bool qp_glyph_cache_send(painter_device_t device, qp_glyph_cache_entry_t *entry, uint32_t pixel_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+#    if QUANTUM_PAINTER_ASYNC_PIXDATA
+    glyph_cache_sending = entry;
+#    endif // QUANTUM_PAINTER_ASYNC_PIXDATA
+    return driver->driver_vtable->pixdata(device, entry->pixdata, pixel_count);
+}
+
+static void qp_glyph_cache_invalidate_font(qff_font_handle_t *qff_font) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (glyph_cache[i].font == qff_font) {
+            glyph_cache[i].device = NULL;
+        }
+    }
+}
+
+// Pixel output callback, decoding a glyph straight into its cache entry
+typedef struct qp_glyph_cache_output_state_t {
+    painter_device_t device;
+    uint8_t *        target_buffer;
+    uint32_t         pixel_write_pos;
+} qp_glyph_cache_output_state_t;
+
+static bool qp_glyph_cache_pixel_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_glyph_cache_output_state_t *state  = (qp_glyph_cache_output_state_t *)cb_arg;
+    painter_driver_t *             driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->target_buffer, palette, state->pixel_write_pos++, 1, &index);
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -73,21 +168,23 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
     font->owns_buffer = false;
     font->buffer      = NULL;
 
-    void *ram_buffer = malloc(font->mem_stream.length);
+    uint32_t length     = qff_get_total_size(&font->stream);
+    void    *ram_buffer = malloc(length);
     if (ram_buffer == NULL) {
         qp_dprintf("qp_load_font: could not allocate enough RAM for font, falling back to original\n");
     } else {
         do {
             // Copy the data into RAM
-            if (qp_stream_read(ram_buffer, 1, font->mem_stream.length, &font->mem_stream) != font->mem_stream.length) {
+            if (qp_stream_read(ram_buffer, 1, length, &font->stream) != length) {
                 qp_dprintf("qp_load_font: could not copy from flash to RAM, falling back to original\n");
+                qp_stream_setpos(&font->stream, 0);
                 break;
             }
 
             // Create the new stream with the new buffer
             font->buffer      = ram_buffer;
             font->owns_buffer = true;
-            font->mem_stream  = qp_make_memory_stream(font->buffer, font->mem_stream.length);
+            font->mem_stream  = qp_make_memory_stream(font->buffer, length);
         } while (0);
     }
 
@@ -132,6 +229,28 @@ painter_font_handle_t qp_load_font_mem(const void *buffer) {
     return qp_load_font_internal(font_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef FLASH_ENABLE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_font_flash
+
+static inline bool font_flash_stream_factory(qff_font_handle_t *font, void *arg) {
+    uint32_t address = *(uint32_t *)arg;
+
+    // Assume we can read the font descriptor
+    font->flash_stream = qp_make_flash_stream(address, sizeof(qff_font_descriptor_v1_t));
+
+    // Update the length of the stream to match, and rewind to the start
+    uint32_t length = qff_get_total_size(&font->stream);
+    flash_read_stream_init(&font->flash_stream.flash, address, length);
+
+    return length > 0;
+}
+
+painter_font_handle_t qp_load_font_flash(uint32_t address) {
+    return qp_load_font_internal(font_flash_stream_factory, &address);
+}
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_font
 
@@ -151,6 +270,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Forget any glyphs rendered from this font, as the handle may be reused for another
+    qp_glyph_cache_invalidate_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -160,8 +284,8 @@ bool qp_close_font(painter_font_handle_t font) {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helpers
 
-// Callback to be invoked for each codepoint detected in the UTF8 input string
-typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
+// Callback to be invoked for each codepoint detected in the UTF8 input string -- it's responsible for preparing the glyph
+typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg);
 
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
@@ -183,8 +307,7 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
     }
 
     // Handle palette if needed
-    const uint16_t palette_entries  = 1u << qff_font->bpp;
-    bool           needs_pixconvert = false;
+    const uint16_t palette_entries = 1u << qff_font->bpp;
     if (qff_font->has_palette) {
         // If this font has a palette, we need to read it out and set up the pixel lookup table
         qp_stream_setpos(&qff_font->stream, offset);
@@ -194,20 +317,20 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
 
         // Skip this block, as far as offset calculations go
         offset += sizeof(qgf_palette_v1_t) + (palette_entries * 3);
-        needs_pixconvert = true;
-    } else {
-        // Interpolate from fg/bg
-        int16_t palette_entries = 1 << qff_font->bpp;
-        needs_pixconvert        = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
-    }
 
-    if (needs_pixconvert) {
         // Convert the palette to native format
         if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
             qp_dprintf("qp_drawtext_recolor: fail (could not convert pixels to native)\n");
             qp_comms_stop(device);
             return false;
         }
+    } else {
+        // Interpolate from fg/bg, reusing an already-converted palette if possible
+        if (!qp_internal_interpolate_palette(device, fg_hsv888, bg_hsv888, palette_entries)) {
+            qp_dprintf("qp_drawtext_recolor: fail (could not convert pixels to native)\n");
+            qp_comms_stop(device);
+            return false;
+        }
     }
 
     *data_offset = offset;
@@ -302,13 +425,7 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
-        uint8_t width;
-        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
-            qp_dprintf("Failed to prepare glyph for rendering.\n");
-            return false;
-        }
-
-        if (!handler(qff_font, code_point, width, qff_font->base.line_height, cb_arg)) {
+        if (!handler(qff_font, code_point, cb_arg)) {
             qp_dprintf("Failed to execute glyph handler.\n");
             return false;
         }
@@ -325,9 +442,25 @@ typedef struct code_point_iter_calcwidth_state_t {
 } code_point_iter_calcwidth_state_t;
 
 // Codepoint handler callback: width calc
-static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_calcwidth_state_t *state = (code_point_iter_calcwidth_state_t *)cb_arg;
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Any rendered copy of the glyph already knows its width
+    qp_pixel_t              unused = {0};
+    qp_glyph_cache_entry_t *entry  = qp_glyph_cache_find(NULL, qff_font, code_point, unused, unused);
+    if (entry) {
+        state->width += entry->width;
+        return true;
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+    uint8_t width;
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
+
     // Increment the overall width by this glyph's width
     state->width += width;
 
@@ -342,19 +475,77 @@ typedef struct code_point_iter_drawglyph_state_t {
     painter_device_t                  device;
     int16_t                           xpos;
     int16_t                           ypos;
+    qp_pixel_t                        fg_hsv888;
+    qp_pixel_t                        bg_hsv888;
+    bool                              palette_ready;
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
 } code_point_iter_drawglyph_state_t;
 
 // Codepoint handler callback: drawing
-static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
+    uint8_t                            height = qff_font->base.line_height;
+    uint8_t                            width;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Palettes embedded in the font don't depend on the requested colors
+    qp_pixel_t fg_hsv888 = qff_font->has_palette ? (qp_pixel_t){0} : state->fg_hsv888;
+    qp_pixel_t bg_hsv888 = qff_font->has_palette ? (qp_pixel_t){0} : state->bg_hsv888;
+
+    // Already rendered in the display's native format, send it as-is
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(state->device, qff_font, code_point, fg_hsv888, bg_hsv888);
+    if (entry) {
+        driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + entry->width - 1, state->ypos + height - 1);
+        state->xpos += entry->width;
+        return qp_glyph_cache_send(state->device, entry, ((uint32_t)entry->width) * height);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
 
-    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
+    // Only set up the palette once something actually needs decoding
+    if (!state->palette_ready) {
+        uint32_t data_offset;
+        if (!qp_drawtext_prepare_font_for_render(state->device, qff_font, state->fg_hsv888, state->bg_hsv888, &data_offset)) {
+            qp_dprintf("Failed to prepare font for rendering.\n");
+            return false;
+        }
+        state->palette_ready = true;
+    }
+
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
+
+    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_drawtext_prepare_glyph_for_render()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Decode into the cache if it fits, then send from there
+    uint32_t pixel_count = ((uint32_t)width) * height;
+    if (qff_font->bpp <= 8 && (pixel_count * driver->native_bits_per_pixel + 7) / 8 <= QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE) {
+        entry                                      = qp_glyph_cache_evict();
+        qp_glyph_cache_output_state_t output_state = {.device = state->device, .target_buffer = entry->pixdata, .pixel_write_pos = 0};
+        if (!qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, qp_glyph_cache_pixel_appender, &output_state)) {
+            return false;
+        }
+
+        entry->device     = state->device;
+        entry->font       = qff_font;
+        entry->code_point = code_point;
+        entry->fg_hsv888  = fg_hsv888;
+        entry->bg_hsv888  = bg_hsv888;
+        entry->width      = width;
+        entry->last_used  = ++glyph_cache_clock;
+
+        driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
+        state->xpos += width;
+        return qp_glyph_cache_send(state->device, entry, pixel_count);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
     // Reset the output state
     state->output_state->pixel_write_pos = 0;
 
@@ -365,8 +556,7 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     state->xpos += width;
 
     // Decode the pixel data for the glyph, and stream it
-    uint32_t pixel_count = ((uint32_t)width) * height;
-    return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
+    return qp_internal_appender(state->device, qff_font->bpp, ((uint32_t)width) * height, state->input_callback, state->input_state);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -428,26 +618,20 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     // Set up the pixel output state
     qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
-    // Set up the codepoint iteration state
+    // Set up the codepoint iteration state -- the palette is prepared on the first glyph that needs decoding
     code_point_iter_drawglyph_state_t state = {// Common
-                                               .device = device,
-                                               .xpos   = x,
-                                               .ypos   = y,
+                                               .device        = device,
+                                               .xpos          = x,
+                                               .ypos          = y,
+                                               .fg_hsv888     = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}},
+                                               .bg_hsv888     = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}},
+                                               .palette_ready = false,
                                                // Input
                                                .input_callback = input_callback,
                                                .input_state    = &input_state,
                                                // Output
                                                .output_state = &output_state};
 
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
-    if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
-        qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
-        qp_comms_stop(device);
-        return false;
-    }
-
     // Iterate the codepoints with the drawglyph callback
     bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
 
@@ -1,12 +1,17 @@
 // Copyright 2021 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string.h>
 #include "qp_stream.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Stream API
 
 uint32_t qp_stream_read_impl(void *output_buf, uint32_t member_size, uint32_t num_members, qp_stream_t *stream) {
+    if (stream->read) {
+        return stream->read(stream, output_buf, num_members * member_size) / member_size;
+    }
+
     uint8_t *output_ptr = (uint8_t *)output_buf;
 
     uint32_t i;
@@ -47,6 +52,21 @@ static inline int16_t mem_get(qp_stream_t *stream) {
     return s->buffer[s->position++];
 }
 
+static inline uint32_t mem_read(qp_stream_t *stream, void *output_buf, uint32_t length) {
+    qp_memory_stream_t *s = (qp_memory_stream_t *)stream;
+    if (s->position >= s->length) {
+        s->is_eof = true;
+        return 0;
+    }
+    if (length > (uint32_t)(s->length - s->position)) {
+        length    = s->length - s->position;
+        s->is_eof = true;
+    }
+    memcpy(output_buf, &s->buffer[s->position], length);
+    s->position += length;
+    return length;
+}
+
 static inline bool mem_put(qp_stream_t *stream, uint8_t c) {
     qp_memory_stream_t *s = (qp_memory_stream_t *)stream;
     if (s->position >= s->length) {
@@ -111,7 +131,7 @@ static inline void mem_close(qp_stream_t *stream) {
 
 qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length) {
     qp_memory_stream_t stream = {
-        .base     = {.get = mem_get, .put = mem_put, .seek = mem_seek, .tell = mem_tell, .is_eof = mem_is_eof, .close = mem_close},
+        .base     = {.get = mem_get, .read = mem_read, .put = mem_put, .seek = mem_seek, .tell = mem_tell, .is_eof = mem_is_eof, .close = mem_close},
         .buffer   = (uint8_t *)buffer,
         .length   = length,
         .position = 0,
@@ -119,6 +139,87 @@ qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length) {
     return stream;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef FLASH_ENABLE
+
+static inline int16_t flash_get(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    uint8_t            c;
+    if (flash_read_stream(&s->flash, &c, 1) != 1) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+    return c;
+}
+
+static inline uint32_t flash_read(qp_stream_t *stream, void *output_buf, uint32_t length) {
+    qp_flash_stream_t *s     = (qp_flash_stream_t *)stream;
+    uint32_t           count = flash_read_stream(&s->flash, output_buf, length);
+    if (count != length) {
+        s->is_eof = true;
+    }
+    return count;
+}
+
+static inline bool flash_put(qp_stream_t *stream, uint8_t c) {
+    // External flash streams are read-only.
+    return false;
+}
+
+static inline int flash_seek(qp_stream_t *stream, int32_t offset, int origin) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+
+    // Handle as per fseek
+    int32_t position = s->flash.position;
+    switch (origin) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position += offset;
+            break;
+        case SEEK_END:
+            position = s->flash.length + offset;
+            break;
+        default:
+            return -1;
+    }
+
+    if (position < 0 || flash_read_stream_seek(&s->flash, position) != FLASH_STATUS_SUCCESS) {
+        return -1;
+    }
+
+    s->is_eof = false;
+    return 0;
+}
+
+static inline int32_t flash_tell(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->flash.position;
+}
+
+static inline bool flash_is_eof(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->is_eof;
+}
+
+static inline void flash_close(qp_stream_t *stream) {
+    // No-op.
+}
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length) {
+    qp_flash_stream_t stream = {
+        .base   = {.get = flash_get, .read = flash_read, .put = flash_put, .seek = flash_seek, .tell = flash_tell, .is_eof = flash_is_eof, .close = flash_close},
+        .is_eof = false,
+    };
+    flash_read_stream_init(&stream.flash, address, length);
+    return stream;
+}
+
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
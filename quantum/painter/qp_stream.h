@@ -23,6 +23,10 @@
 
 #include "qp_internal.h"
 
+#ifdef FLASH_ENABLE
+#    include "flash.h"
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Stream API
 
@@ -50,6 +54,7 @@ uint32_t qp_stream_write_impl(const void *input_buf, uint32_t member_size, uint3
 
 typedef struct qp_stream_t {
     int16_t (*get)(qp_stream_t *stream);
+    uint32_t (*read)(qp_stream_t *stream, void *output_buf, uint32_t length); // optional, bulk alternative to get()
     bool (*put)(qp_stream_t *stream, uint8_t c);
     int (*seek)(qp_stream_t *stream, int32_t offset, int origin);
     int32_t (*tell)(qp_stream_t *stream);
@@ -70,6 +75,21 @@ typedef struct qp_memory_stream_t {
 
 qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef FLASH_ENABLE
+
+typedef struct qp_flash_stream_t {
+    qp_stream_t         base;
+    flash_read_stream_t flash;
+    bool                is_eof;
+} qp_flash_stream_t;
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, int32_t length);
+
+#endif // FLASH_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
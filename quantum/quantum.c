@@ -84,6 +84,10 @@
 #    include "process_layer_lock.h"
 #endif
 
+#ifdef EEPROM_DRIVER
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -229,6 +233,10 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #endif
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
+#endif
+    eeconfig_flush();
+#ifdef EEPROM_DRIVER
+    eeprom_driver_flush();
 #endif
 }
 
@@ -550,6 +558,10 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 void suspend_power_down_quantum(void) {
     suspend_power_down_modules();
     suspend_power_down_kb();
+    eeconfig_flush();
+#ifdef EEPROM_DRIVER
+    eeprom_driver_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
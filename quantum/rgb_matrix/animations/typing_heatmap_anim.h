@@ -16,79 +16,178 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+
+#        if defined(RGB_MATRIX_TYPING_HEATMAP_NEIGHBOUR_CACHE) && !defined(RGB_MATRIX_TYPING_HEATMAP_NEIGHBOUR_CACHE_SIZE)
+#            define RGB_MATRIX_TYPING_HEATMAP_NEIGHBOUR_CACHE_SIZE (RGB_MATRIX_LED_COUNT * 12)
+#        endif
+
+// Heat decays lazily: each cell remembers the decay tick it was last brought
+// up to date at, and the pending decrements are applied whenever the cell is
+// next read or written. Ticks are 16 bits wide, so cells which aren't rendered,
+// or sit through a suspend, can go untouched for minutes without their age
+// wrapping; anything older than 255 ticks has fully decayed anyway.
+static uint16_t heatmap_stamp[MATRIX_ROWS][MATRIX_COLS];
+
+static inline uint16_t heatmap_decay_tick(void) {
+    return sync_timer_read32() / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+}
+
+static inline uint8_t heatmap_decay(uint8_t row, uint8_t col, uint16_t now) {
+    uint16_t elapsed        = now - heatmap_stamp[row][col];
+    heatmap_stamp[row][col] = now;
+    return g_rgb_frame_buffer[row][col] = qsub8(g_rgb_frame_buffer[row][col], elapsed > UINT8_MAX ? UINT8_MAX : elapsed);
+}
+
+static inline void heatmap_add(uint8_t row, uint8_t col, uint8_t amount, uint16_t now) {
+    g_rgb_frame_buffer[row][col] = qadd8(heatmap_decay(row, col, now), amount);
+}
+
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+// Heat spread from one LED to another, or zero when they are too far apart.
+static uint8_t heatmap_spread_amount(uint8_t from, uint8_t to) {
+    int16_t  dx = g_led_config.point[from].x - g_led_config.point[to].x;
+    int16_t  dy = g_led_config.point[from].y - g_led_config.point[to].y;
+    uint32_t d2 = (uint32_t)(dx * dx) + (uint32_t)(dy * dy);
+    // Cheap rejection before the square root; sqrt16() of anything at or
+    // above (SPREAD + 1)^2 is always outside the spread.
+    if (d2 >= (uint32_t)(RGB_MATRIX_TYPING_HEATMAP_SPREAD + 1) * (RGB_MATRIX_TYPING_HEATMAP_SPREAD + 1)) {
+        return 0;
+    }
+    uint8_t distance = sqrt16(d2);
+    if (distance > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+        return 0;
+    }
+    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+    }
+    return amount;
+}
+
+#            ifdef RGB_MATRIX_TYPING_HEATMAP_NEIGHBOUR_CACHE
+typedef struct PACKED {
+    uint8_t row;
+    uint8_t col;
+    uint8_t amount;
+} heatmap_neighbour_t;
+
+// Neighbour lists of all keys, packed back to back. Keys whose list did not
+// fit are marked with UINT16_MAX and fall back to scanning the whole matrix.
+static heatmap_neighbour_t heatmap_neighbours[RGB_MATRIX_TYPING_HEATMAP_NEIGHBOUR_CACHE_SIZE];
+static uint16_t            heatmap_neighbour_start[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t             heatmap_neighbour_count[MATRIX_ROWS][MATRIX_COLS];
+static bool                heatmap_neighbours_valid = false;
+
+static void heatmap_build_neighbours(void) {
+    uint16_t used = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            heatmap_neighbour_start[row][col] = UINT16_MAX;
+            heatmap_neighbour_count[row][col] = 0;
+            uint8_t led                       = g_led_config.matrix_co[row][col];
+            if (led == NO_LED) {
+                continue;
+            }
+
+            uint16_t start = used;
+            bool     fits  = true;
+            for (uint8_t i_row = 0; i_row < MATRIX_ROWS && fits; i_row++) {
+                for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+                    uint8_t i_led = g_led_config.matrix_co[i_row][i_col];
+                    if (i_led == NO_LED || (i_row == row && i_col == col)) {
+                        continue;
+                    }
+                    uint8_t amount = heatmap_spread_amount(led, i_led);
+                    if (!amount) {
+                        continue;
+                    }
+                    if (used == RGB_MATRIX_TYPING_HEATMAP_NEIGHBOUR_CACHE_SIZE || used - start == UINT8_MAX) {
+                        fits = false;
+                        break;
+                    }
+                    heatmap_neighbours[used++] = (heatmap_neighbour_t){.row = i_row, .col = i_col, .amount = amount};
+                }
+            }
+
+            if (fits) {
+                heatmap_neighbour_start[row][col] = start;
+                heatmap_neighbour_count[row][col] = used - start;
+            } else {
+                used = start;
+            }
+        }
+    }
+    heatmap_neighbours_valid = true;
+}
+#            endif
+#        endif
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
+    uint16_t now = heatmap_decay_tick();
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+    heatmap_add(row, col, RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP, now);
 #        else
-    if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) { // skip as pressed key doesn't have an led position
+        return;
+    }
+    heatmap_add(row, col, RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP, now);
+
+#            ifdef RGB_MATRIX_TYPING_HEATMAP_NEIGHBOUR_CACHE
+    if (heatmap_neighbours_valid && heatmap_neighbour_start[row][col] != UINT16_MAX) {
+        const heatmap_neighbour_t* neighbour = &heatmap_neighbours[heatmap_neighbour_start[row][col]];
+        for (uint8_t i = 0; i < heatmap_neighbour_count[row][col]; i++, neighbour++) {
+            heatmap_add(neighbour->row, neighbour->col, neighbour->amount, now);
+        }
         return;
     }
+#            endif
+
     for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
         for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
-            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
+            uint8_t i_led = g_led_config.matrix_co[i_row][i_col];
+            if (i_led == NO_LED || (i_row == row && i_col == col)) { // skip as target key doesn't have an led position
                 continue;
             }
-            if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-            } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
+            uint8_t amount = heatmap_spread_amount(led, i_led);
+            if (amount) {
+                heatmap_add(i_row, i_col, amount, now);
             }
         }
     }
 #        endif
 }
 
-// A timer to track the last time we decremented all heatmap values.
-static uint16_t heatmap_decrease_timer;
-// Whether we should decrement the heatmap values during the next update.
-static bool decrease_heatmap_values;
-
 bool TYPING_HEATMAP(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
+    uint16_t now = heatmap_decay_tick();
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
         memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
-    }
-
-    // The heatmap animation might run in several iterations depending on
-    // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
-    // timer when the animation starts.
-    if (params->iter == 0) {
-        decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
-
-        // Restart the timer if we are going to decrease the heatmap this frame.
-        if (decrease_heatmap_values) {
-            heatmap_decrease_timer = timer_read();
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                heatmap_stamp[row][col] = now;
+            }
         }
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && defined(RGB_MATRIX_TYPING_HEATMAP_NEIGHBOUR_CACHE)
+        heatmap_build_neighbours();
+#        endif
     }
 
-    // Render heatmap & decrease
+    // Render heatmap, catching up on any pending decay as we go
     uint8_t count = 0;
     for (uint8_t row = 0; row < MATRIX_ROWS && count < RGB_MATRIX_LED_PROCESS_LIMIT; row++) {
         for (uint8_t col = 0; col < MATRIX_COLS && RGB_MATRIX_LED_PROCESS_LIMIT; col++) {
             if (g_led_config.matrix_co[row][col] >= led_min && g_led_config.matrix_co[row][col] < led_max) {
                 count++;
-                uint8_t val = g_rgb_frame_buffer[row][col];
+                uint8_t val = heatmap_decay(row, col, now);
                 if (!HAS_ANY_FLAGS(g_led_config.flags[g_led_config.matrix_co[row][col]], params->flags)) continue;
 
                 hsv_t hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
                 rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
                 rgb_matrix_set_color(g_led_config.matrix_co[row][col], rgb.r, rgb.g, rgb.b);
-
-                if (decrease_heatmap_values) {
-                    g_rgb_frame_buffer[row][col] = qsub8(val, 1);
-                }
             }
         }
     }
@@ -29,6 +29,13 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef RGB_MATRIX_RENDER_THREAD
+#    ifndef PROTOCOL_CHIBIOS
+#        error "RGB_MATRIX_RENDER_THREAD is only supported on ChibiOS"
+#    endif
+#    include <ch.h>
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -39,6 +46,23 @@ __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Keyboards overriding rgb_matrix_hsv_to_rgb() need to override this as well
+// when RGB_MATRIX_HSV_TO_RGB_BATCH is enabled.
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint8_t count) {
+    hsv_to_rgb_batch(hsv, rgb, count);
+}
+
+#ifdef RGB_MATRIX_HSV_TO_RGB_BATCH
+void rgb_matrix_hsv_batch_flush(rgb_matrix_hsv_batch_t *batch) {
+    rgb_t rgb[RGB_MATRIX_HSV_BATCH_SIZE];
+    rgb_matrix_hsv_to_rgb_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t i = 0; i < batch->count; i++) {
+        rgb_matrix_set_color(batch->index[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+    batch->count = 0;
+}
+#endif // RGB_MATRIX_HSV_TO_RGB_BATCH
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -88,6 +112,28 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
 
+// render thread
+#ifdef RGB_MATRIX_RENDER_THREAD
+// Between rgb_render_go and rgb_render_done the render thread owns the back buffer and the effect state, while the
+// main loop carries on scanning. Only the main loop advances rgb_task_state, once the thread has posted its result.
+static rgb_t              rgb_render_buffers[2][RGB_MATRIX_LED_COUNT];
+static rgb_t             *rgb_render_back   = rgb_render_buffers[0];
+static rgb_t             *rgb_render_front  = rgb_render_buffers[1];
+static uint8_t            rgb_render_effect = 0;
+static bool               rgb_render_busy   = false; // main loop only
+static volatile bool      rgb_render_cancel = false;
+static rgb_task_states    rgb_render_next   = SYNCING;
+static thread_t          *rgb_render_thread = NULL;
+static binary_semaphore_t rgb_render_go;
+static binary_semaphore_t rgb_render_done;
+// Guards the frame buffer, which key events update while effects read it
+static mutex_t rgb_render_lock;
+
+static inline bool rgb_matrix_in_render_thread(void) {
+    return chThdGetSelfX() == rgb_render_thread;
+}
+#endif // RGB_MATRIX_RENDER_THREAD
+
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, EECONFIG_RGB_MATRIX, rgb_matrix_config);
 
 void eeconfig_update_rgb_matrix(void) {
@@ -153,10 +199,26 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_RENDER_THREAD
+    // effects draw into the back buffer, everything else goes straight to the driver
+    if (rgb_matrix_in_render_thread()) {
+        if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+            rgb_render_back[index] = (rgb_t){.r = red, .g = green, .b = blue};
+        }
+        return;
+    }
+#endif // RGB_MATRIX_RENDER_THREAD
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_RENDER_THREAD
+    if (rgb_matrix_in_render_thread()) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
+            rgb_render_back[i] = (rgb_t){.r = red, .g = green, .b = blue};
+        return;
+    }
+#endif // RGB_MATRIX_RENDER_THREAD
 #if defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
@@ -209,7 +271,13 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
 #    endif // defined(RGB_MATRIX_KEYRELEASES)
     {
         if (rgb_matrix_config.mode == RGB_MATRIX_TYPING_HEATMAP) {
+#    ifdef RGB_MATRIX_RENDER_THREAD
+            chMtxLock(&rgb_render_lock);
             process_rgb_matrix_typing_heatmap(row, col);
+            chMtxUnlock(&rgb_render_lock);
+#    else
+            process_rgb_matrix_typing_heatmap(row, col);
+#    endif // RGB_MATRIX_RENDER_THREAD
         }
     }
 #endif // defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
@@ -287,7 +355,7 @@ static void rgb_task_start(void) {
     rgb_task_state = RENDERING;
 }
 
-static void rgb_task_render(uint8_t effect) {
+static rgb_task_states rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
     if (rgb_effect_params.flags != rgb_matrix_config.flags) {
@@ -330,21 +398,21 @@ static void rgb_task_render(uint8_t effect) {
         // Factory default magic value
         case UINT8_MAX: {
             rgb_matrix_test();
-            rgb_task_state = FLUSHING;
         }
-            return;
+            return FLUSHING;
     }
 
     rgb_effect_params.iter++;
 
     // next task
-    if (!rendering) {
-        rgb_task_state = FLUSHING;
-        if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE) {
-            // We only need to flush once if we are RGB_MATRIX_NONE
-            rgb_task_state = SYNCING;
-        }
+    if (rendering) {
+        return RENDERING;
+    }
+    if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE) {
+        // We only need to flush once if we are RGB_MATRIX_NONE
+        return SYNCING;
     }
+    return FLUSHING;
 }
 
 static void rgb_task_flush(uint8_t effect) {
@@ -359,6 +427,75 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_task_state = SYNCING;
 }
 
+#ifdef RGB_MATRIX_RENDER_THREAD
+static THD_WORKING_AREA(waRgbMatrixRenderThread, RGB_MATRIX_RENDER_THREAD_STACK_SIZE);
+static THD_FUNCTION(RgbMatrixRenderThread, arg) {
+    (void)arg;
+    chRegSetThreadName("rgb_matrix_render");
+
+    while (true) {
+        chBSemWait(&rgb_render_go);
+
+        // Start from the last flushed frame, as some effects only touch a subset of LEDs per frame
+        memcpy(rgb_render_back, rgb_render_front, sizeof(rgb_render_buffers[0]));
+
+        // Yield after every iteration so the main loop keeps scanning while heavy effects render
+        rgb_task_states next;
+        do {
+            chMtxLock(&rgb_render_lock);
+            next = rgb_task_render(rgb_render_effect);
+            chMtxUnlock(&rgb_render_lock);
+            chThdYield();
+        } while (next == RENDERING && !rgb_render_cancel);
+
+        rgb_render_next = next;
+        chBSemSignal(&rgb_render_done);
+    }
+}
+
+// Collects the render thread's result without blocking, returns false while it's still rendering
+static bool rgb_render_collect(void) {
+    if (rgb_render_busy) {
+        if (chBSemWaitTimeout(&rgb_render_done, TIME_IMMEDIATE) != MSG_OK) {
+            return false;
+        }
+        rgb_render_busy = false;
+    }
+    return true;
+}
+
+static void rgb_task_swap(void) {
+    rgb_t *front     = rgb_render_back;
+    rgb_render_back  = rgb_render_front;
+    rgb_render_front = front;
+
+    uint8_t led_min = 0;
+    uint8_t led_max = RGB_MATRIX_LED_COUNT;
+#    if defined(RGB_MATRIX_SPLIT)
+    if (is_keyboard_left()) {
+        led_max = k_rgb_matrix_split[0];
+    } else {
+        led_min = k_rgb_matrix_split[0];
+    }
+#    endif
+    for (uint8_t i = led_min; i < led_max; i++) {
+        rgb_matrix_set_color(i, front[i].r, front[i].g, front[i].b);
+    }
+
+    // Indicators run on the main loop, on top of the completed frame
+    if (rgb_render_effect) {
+        uint8_t iters = rgb_effect_params.iter ? rgb_effect_params.iter : 1;
+        for (uint8_t i = 1; i <= iters; i++) {
+            rgb_effect_params.iter = i;
+            if (i == iters) {
+                rgb_matrix_indicators();
+            }
+            rgb_matrix_indicators_advanced(&rgb_effect_params);
+        }
+    }
+}
+#endif // RGB_MATRIX_RENDER_THREAD
+
 void rgb_matrix_task(void) {
     rgb_task_timers();
 
@@ -373,11 +510,38 @@ void rgb_matrix_task(void) {
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
     switch (rgb_task_state) {
+#ifdef RGB_MATRIX_RENDER_THREAD
         case STARTING:
+            // an interrupted frame is abandoned, but has to wind down before the effect state can be reset
+            rgb_render_cancel = rgb_render_busy;
+            if (!rgb_render_collect()) {
+                chThdYield();
+                break;
+            }
+            rgb_render_cancel = false;
             rgb_task_start();
+            rgb_render_effect = effect;
+            rgb_render_busy   = true;
+            chBSemSignal(&rgb_render_go);
             break;
         case RENDERING:
-            rgb_task_render(effect);
+            // the frame is only swapped in once the render thread has completed it
+            if (!rgb_render_collect()) {
+                chThdYield();
+                break;
+            }
+            rgb_task_state = rgb_render_next;
+            break;
+        case FLUSHING:
+            rgb_task_swap();
+            rgb_task_flush(rgb_render_effect);
+            break;
+#else
+        case STARTING:
+            rgb_task_start();
+            break;
+        case RENDERING:
+            rgb_task_state = rgb_task_render(effect);
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
                     rgb_matrix_indicators();
@@ -388,6 +552,7 @@ void rgb_matrix_task(void) {
         case FLUSHING:
             rgb_task_flush(effect);
             break;
+#endif // RGB_MATRIX_RENDER_THREAD
         case SYNCING:
             rgb_task_sync();
             break;
@@ -455,6 +620,13 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_RENDER_THREAD
+    chBSemObjectInit(&rgb_render_go, true);
+    chBSemObjectInit(&rgb_render_done, true);
+    chMtxObjectInit(&rgb_render_lock);
+    rgb_render_thread = chThdCreateStatic(waRgbMatrixRenderThread, sizeof(waRgbMatrixRenderThread), RGB_MATRIX_RENDER_THREAD_PRIORITY, RgbMatrixRenderThread, NULL);
+#endif // RGB_MATRIX_RENDER_THREAD
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -478,6 +650,14 @@ void rgb_matrix_init(void) {
 void rgb_matrix_set_suspend_state(bool state) {
 #ifdef RGB_MATRIX_SLEEP
     if (state && !suspend_state) { // only run if turning off, and only once
+#    ifdef RGB_MATRIX_RENDER_THREAD
+        rgb_render_cancel = rgb_render_busy;
+        while (!rgb_render_collect()) { // let the render thread finish before touching the effect state
+            chThdYield();
+        }
+        rgb_render_cancel = false;
+        memset(rgb_render_buffers, 0, sizeof(rgb_render_buffers));
+#    endif
         rgb_task_render(0);        // turn off all LEDs when suspending
         rgb_task_flush(0);         // and actually flash led state to LEDs
     }
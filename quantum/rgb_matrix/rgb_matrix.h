@@ -90,6 +90,15 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifdef RGB_MATRIX_RENDER_THREAD
+#    ifndef RGB_MATRIX_RENDER_THREAD_STACK_SIZE
+#        define RGB_MATRIX_RENDER_THREAD_STACK_SIZE 512
+#    endif
+#    ifndef RGB_MATRIX_RENDER_THREAD_PRIORITY
+#        define RGB_MATRIX_RENDER_THREAD_PRIORITY NORMALPRIO
+#    endif
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -114,6 +123,42 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
 #define RGB_MATRIX_TEST_LED_FLAGS() \
     if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
 
+#ifdef RGB_MATRIX_HSV_TO_RGB_BATCH
+#    ifndef RGB_MATRIX_HSV_BATCH_SIZE
+#        define RGB_MATRIX_HSV_BATCH_SIZE 16
+#    endif
+
+typedef struct {
+    uint8_t count;
+    uint8_t index[RGB_MATRIX_HSV_BATCH_SIZE];
+    hsv_t   hsv[RGB_MATRIX_HSV_BATCH_SIZE];
+} rgb_matrix_hsv_batch_t;
+
+void rgb_matrix_hsv_batch_flush(rgb_matrix_hsv_batch_t *batch);
+
+static inline void rgb_matrix_hsv_batch_push(rgb_matrix_hsv_batch_t *batch, uint8_t index, hsv_t hsv) {
+    batch->index[batch->count] = index;
+    batch->hsv[batch->count]   = hsv;
+    if (++batch->count == RGB_MATRIX_HSV_BATCH_SIZE) {
+        rgb_matrix_hsv_batch_flush(batch);
+    }
+}
+
+#    define RGB_MATRIX_HSV_BATCH_BEGIN()   \
+        rgb_matrix_hsv_batch_t hsv_batch; \
+        hsv_batch.count = 0
+#    define RGB_MATRIX_HSV_BATCH_SET(i, hsv) rgb_matrix_hsv_batch_push(&hsv_batch, i, hsv)
+#    define RGB_MATRIX_HSV_BATCH_END() rgb_matrix_hsv_batch_flush(&hsv_batch)
+#else
+#    define RGB_MATRIX_HSV_BATCH_BEGIN()
+#    define RGB_MATRIX_HSV_BATCH_SET(i, hsv)                                   \
+        do {                                                                   \
+            rgb_t batch_rgb = rgb_matrix_hsv_to_rgb(hsv);                      \
+            rgb_matrix_set_color(i, batch_rgb.r, batch_rgb.g, batch_rgb.b);    \
+        } while (0)
+#    define RGB_MATRIX_HSV_BATCH_END()
+#endif
+
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
 
@@ -150,6 +195,9 @@ int rgb_matrix_led_index(int index);
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv);
+void  rgb_matrix_hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint8_t count);
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
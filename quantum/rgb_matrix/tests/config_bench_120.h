@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+#include "config_bench_common.h"
+
+#define MATRIX_ROWS 6
+#define MATRIX_COLS 20
+#define RGB_MATRIX_LED_COUNT 120
+#define RGB_MATRIX_BENCH_GOLDEN "rgb_matrix_golden_120.inc"
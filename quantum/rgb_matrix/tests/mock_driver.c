@@ -0,0 +1,102 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdlib.h>
+#include <string.h>
+#include "eeprom.h"
+#include "eeconfig.h"
+#include "rgb_matrix.h"
+#include "lib/lib8tion/lib8tion.h"
+#include "mock_driver.h"
+
+rgb_t    mock_leds[RGB_MATRIX_LED_COUNT];
+uint32_t mock_flush_count = 0;
+
+led_config_t g_led_config;
+
+static void mock_init(void) {}
+
+static void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        mock_leds[index] = (rgb_t){.r = r, .g = g, .b = b};
+    }
+}
+
+static void mock_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        mock_set_color(i, r, g, b);
+    }
+}
+
+static void mock_flush(void) {
+    mock_flush_count++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = mock_init,
+    .set_color     = mock_set_color,
+    .set_color_all = mock_set_color_all,
+    .flush         = mock_flush,
+};
+
+void mock_driver_reset(void) {
+    memset(mock_leds, 0, sizeof(mock_leds));
+    mock_flush_count = 0;
+}
+
+/* Synthetic layout: one LED per matrix position, laid out on the usual
+ * 224x64 grid with a small per-row stagger. The outer columns are flagged
+ * as modifiers so that ALPHAS_MODS has something to distinguish. */
+void mock_layout_init(void) {
+    memset(&g_led_config, 0, sizeof(g_led_config));
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint16_t led = row * MATRIX_COLS + col;
+            if (led >= RGB_MATRIX_LED_COUNT) {
+                g_led_config.matrix_co[row][col] = NO_LED;
+                continue;
+            }
+            g_led_config.matrix_co[row][col] = led;
+            g_led_config.point[led].x        = (col * 224 + (row * 224) / (4 * MATRIX_ROWS)) / MATRIX_COLS;
+            g_led_config.point[led].y        = (MATRIX_ROWS > 1) ? row * 64 / (MATRIX_ROWS - 1) : 32;
+            g_led_config.flags[led]          = (col == 0 || col == MATRIX_COLS - 1) ? LED_FLAG_MODIFIER : LED_FLAG_KEYLIGHT;
+        }
+    }
+}
+
+void mock_random_reset(void) {
+    random16_set_seed(1337); // RAND16_SEED from lib8tion.c
+    srand(1);
+}
+
+static const char *effect_names[] = {
+    "NONE",
+#define RGB_MATRIX_EFFECT(name, ...) #name,
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+
+uint8_t mock_effect_count(void) {
+    return RGB_MATRIX_EFFECT_MAX;
+}
+
+const char *mock_effect_name(uint8_t mode) {
+    return mode < RGB_MATRIX_EFFECT_MAX ? effect_names[mode] : "UNKNOWN";
+}
+
+bool is_keyboard_master(void) {
+    return true;
+}
+
+bool is_keyboard_left(void) {
+    return true;
+}
+
+// The bench doesn't link eeconfig.c, so go straight to the test EEPROM
+void eeconfig_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_read_block(buf, addr, len);
+}
+
+void eeconfig_update_block(const void *buf, void *addr, size_t len) {
+    eeprom_update_block(buf, addr, len);
+}
@@ -0,0 +1,31 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "color.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern rgb_t    mock_leds[RGB_MATRIX_LED_COUNT];
+extern uint32_t mock_flush_count;
+
+void mock_driver_reset(void);
+void mock_layout_init(void);
+void mock_random_reset(void);
+
+uint8_t     mock_effect_count(void);
+const char *mock_effect_name(uint8_t mode);
+
+// rgb_matrix.h is not C++ friendly, so only pull in what the benchmark needs
+void rgb_matrix_init(void);
+void rgb_matrix_task(void);
+void rgb_matrix_mode_noeeprom(uint8_t mode);
+void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
+
+#ifdef __cplusplus
+}
+#endif
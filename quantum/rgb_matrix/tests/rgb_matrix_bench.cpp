@@ -0,0 +1,126 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+#include "fnv.h"
+#include "mock_driver.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#ifndef RGB_MATRIX_BENCH_FRAMES
+#    define RGB_MATRIX_BENCH_FRAMES 256
+#endif
+
+// Simulated keypresses for the reactive and heatmap effects, one every N frames
+#ifndef RGB_MATRIX_BENCH_KEYPRESS_INTERVAL
+#    define RGB_MATRIX_BENCH_KEYPRESS_INTERVAL 8
+#endif
+
+struct golden_frame_t {
+    const char *name;
+    uint32_t    checksum;
+};
+
+static const golden_frame_t golden_frames[] = {
+#define RGB_MATRIX_GOLDEN(name, checksum) {#name, checksum},
+#ifdef RGB_MATRIX_BENCH_GOLDEN
+#    include RGB_MATRIX_BENCH_GOLDEN
+#endif
+#undef RGB_MATRIX_GOLDEN
+    {nullptr, 0},
+};
+
+static const golden_frame_t *find_golden(const char *name) {
+    for (const golden_frame_t *g = golden_frames; g->name != nullptr; g++) {
+        if (strcmp(g->name, name) == 0) {
+            return g;
+        }
+    }
+    return nullptr;
+}
+
+struct bench_result_t {
+    uint64_t elapsed_ns;
+    uint32_t frames;
+    uint32_t checksum;
+};
+
+/* Runs the rgb_matrix task loop until the requested number of frames have been
+ * flushed to the mock driver, folding every flushed frame into the checksum.
+ * Only time spent inside rgb_matrix_task() is measured. */
+static bench_result_t run_effect(uint8_t mode) {
+    bench_result_t result = {0, 0, FNV1_32A_INIT};
+
+    // Each effect starts from its own point in time, so statics inside the
+    // effects never see a timer going backwards, whatever order tests run in.
+    set_time((uint32_t)mode * 1000000);
+    mock_random_reset();
+    mock_driver_reset();
+    rgb_matrix_init();
+    rgb_matrix_mode_noeeprom(mode);
+
+    uint32_t last_flush = mock_flush_count;
+    uint8_t  key_row    = 0;
+    uint8_t  key_col    = 0;
+    bool     key_down   = false;
+
+    while (result.frames < RGB_MATRIX_BENCH_FRAMES) {
+        auto start = std::chrono::steady_clock::now();
+        rgb_matrix_task();
+        auto end = std::chrono::steady_clock::now();
+        result.elapsed_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        if (mock_flush_count != last_flush) {
+            last_flush = mock_flush_count;
+            result.checksum = fnv_32a_buf(mock_leds, sizeof(mock_leds), result.checksum);
+            result.frames++;
+
+            if (key_down) {
+                rgb_matrix_handle_key_event(key_row, key_col, false);
+                key_down = false;
+            } else if (result.frames % RGB_MATRIX_BENCH_KEYPRESS_INTERVAL == 0) {
+                key_row = (result.frames * 7) % MATRIX_ROWS;
+                key_col = (result.frames * 13) % MATRIX_COLS;
+                rgb_matrix_handle_key_event(key_row, key_col, true);
+                key_down = true;
+            }
+        }
+
+        advance_time(1);
+    }
+
+    return result;
+}
+
+class RgbMatrixBench : public ::testing::TestWithParam<uint8_t> {
+   protected:
+    void SetUp() override {
+        mock_layout_init();
+    }
+};
+
+TEST_P(RgbMatrixBench, Effect) {
+    uint8_t     mode = GetParam();
+    const char *name = mock_effect_name(mode);
+
+    bench_result_t result = run_effect(mode);
+    ASSERT_EQ(result.frames, RGB_MATRIX_BENCH_FRAMES);
+
+    uint64_t ns_per_frame = result.elapsed_ns / result.frames;
+    printf("%-28s %3d LEDs: %8llu ns/frame %6llu ns/LED\n", name, RGB_MATRIX_LED_COUNT, (unsigned long long)ns_per_frame, (unsigned long long)(ns_per_frame / RGB_MATRIX_LED_COUNT));
+    printf("RGB_MATRIX_GOLDEN(%s, 0x%08X)\n", name, (unsigned)result.checksum);
+
+    const golden_frame_t *golden = find_golden(name);
+    if (golden != nullptr) {
+        EXPECT_EQ(result.checksum, golden->checksum) << "Rendered frames of " << name << " no longer match the golden checksum";
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(AllEffects, RgbMatrixBench, ::testing::Range<uint8_t>(1, mock_effect_count()), [](const ::testing::TestParamInfo<uint8_t> &info) { return std::string(mock_effect_name(info.param)); });
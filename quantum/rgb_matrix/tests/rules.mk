@@ -0,0 +1,64 @@
+rgb_matrix_bench_common_DEFS := \
+	-DRGB_MATRIX_ENABLE \
+	-DRGB_MATRIX_CUSTOM \
+	-DEEPROM_TEST_HARNESS \
+	-DNO_DEBUG
+rgb_matrix_bench_common_SRC := \
+	platforms/timer.c \
+	platforms/test/timer.c \
+	platforms/test/eeprom.c \
+	$(LIB_PATH)/fnv/qmk_fnv_type_validation.c \
+	$(LIB_PATH)/fnv/hash_32a.c \
+	$(LIB_PATH)/lib8tion/lib8tion.c \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/led_tables.c \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/mock_driver.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_bench.cpp
+rgb_matrix_bench_common_INC := \
+	$(LIB_PATH)/fnv \
+	$(QUANTUM_PATH)/rgb_matrix \
+	$(QUANTUM_PATH)/rgb_matrix/animations \
+	$(QUANTUM_PATH)/rgb_matrix/animations/runners \
+	$(QUANTUM_PATH)/rgb_matrix/tests
+
+rgb_matrix_bench_60_DEFS := \
+	$(rgb_matrix_bench_common_DEFS)
+rgb_matrix_bench_60_CONFIG := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/config_bench_60.h \
+	$(QUANTUM_PATH)/rgb_matrix/post_config.h
+rgb_matrix_bench_60_SRC := \
+	$(rgb_matrix_bench_common_SRC)
+rgb_matrix_bench_60_INC := \
+	$(rgb_matrix_bench_common_INC)
+
+rgb_matrix_bench_120_DEFS := \
+	$(rgb_matrix_bench_common_DEFS)
+rgb_matrix_bench_120_CONFIG := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/config_bench_120.h \
+	$(QUANTUM_PATH)/rgb_matrix/post_config.h
+rgb_matrix_bench_120_SRC := \
+	$(rgb_matrix_bench_common_SRC)
+rgb_matrix_bench_120_INC := \
+	$(rgb_matrix_bench_common_INC)
+
+rgb_matrix_bench_250_DEFS := \
+	$(rgb_matrix_bench_common_DEFS)
+rgb_matrix_bench_250_CONFIG := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/config_bench_250.h \
+	$(QUANTUM_PATH)/rgb_matrix/post_config.h
+rgb_matrix_bench_250_SRC := \
+	$(rgb_matrix_bench_common_SRC)
+rgb_matrix_bench_250_INC := \
+	$(rgb_matrix_bench_common_INC)
+
+rgb_matrix_bench_120_batch_DEFS := \
+	$(rgb_matrix_bench_common_DEFS) \
+	-DRGB_MATRIX_HSV_TO_RGB_BATCH
+rgb_matrix_bench_120_batch_CONFIG := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/config_bench_120.h \
+	$(QUANTUM_PATH)/rgb_matrix/post_config.h
+rgb_matrix_bench_120_batch_SRC := \
+	$(rgb_matrix_bench_common_SRC)
+rgb_matrix_bench_120_batch_INC := \
+	$(rgb_matrix_bench_common_INC)
@@ -0,0 +1,5 @@
+TEST_LIST += \
+	rgb_matrix_bench_60 \
+	rgb_matrix_bench_120 \
+	rgb_matrix_bench_250 \
+	rgb_matrix_bench_120_batch
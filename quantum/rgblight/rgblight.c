@@ -26,6 +26,7 @@
 #include <lib/lib8tion/lib8tion.h>
 #ifdef EEPROM_ENABLE
 #    include "eeprom.h"
+#    include "eeconfig.h"
 #endif
 
 #ifdef RGBLIGHT_SPLIT
@@ -178,7 +179,11 @@ void rgblight_check_config(void) {
 
 uint64_t eeconfig_read_rgblight(void) {
 #ifdef EEPROM_ENABLE
-    return (uint64_t)((eeprom_read_dword(EECONFIG_RGBLIGHT)) | ((uint64_t)eeprom_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32));
+    uint32_t val = 0;
+    uint8_t  ext = 0;
+    eeconfig_read_block(&val, EECONFIG_RGBLIGHT, sizeof(val));
+    eeconfig_read_block(&ext, EECONFIG_RGBLIGHT_EXTENDED, sizeof(ext));
+    return (uint64_t)val | ((uint64_t)ext << 32);
 #else
     return 0;
 #endif
@@ -187,8 +192,10 @@ uint64_t eeconfig_read_rgblight(void) {
 void eeconfig_update_rgblight(uint64_t val) {
 #ifdef EEPROM_ENABLE
     rgblight_check_config();
-    eeprom_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (val >> 32) & 0xFF);
+    uint32_t base = val & 0xFFFFFFFF;
+    uint8_t  ext  = (val >> 32) & 0xFF;
+    eeconfig_update_block(&base, EECONFIG_RGBLIGHT, sizeof(base));
+    eeconfig_update_block(&ext, EECONFIG_RGBLIGHT_EXTENDED, sizeof(ext));
 #endif
 }
 
@@ -27,6 +27,10 @@
 #    include "eeconfig.h"
 #endif
 
+#ifdef SPLIT_TRANSPORT_STATS_ENABLE
+#    include "transport_stats.h"
+#endif
+
 #if defined(RGBLIGHT_ENABLE) && defined(RGBLED_SPLIT)
 #    include "rgblight.h"
 #endif
@@ -245,11 +249,19 @@ bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t sl
 #endif // SPLIT_MAX_CONNECTION_ERRORS > 0 && SPLIT_CONNECTION_CHECK_TIMEOUT > 0
 
     __attribute__((unused)) bool okay = transport_master(master_matrix, slave_matrix);
+#ifdef SPLIT_TRANSPORT_STATS_ENABLE
+    split_transport_stats_record_cycle(okay);
+#endif // SPLIT_TRANSPORT_STATS_ENABLE
 #if SPLIT_MAX_CONNECTION_ERRORS > 0
     if (!okay) {
         if (connection_errors < UINT8_MAX) {
             connection_errors++;
         }
+#    ifdef SPLIT_TRANSPORT_STATS_ENABLE
+        if (connection_errors == SPLIT_MAX_CONNECTION_ERRORS) {
+            split_transport_stats_record_disconnect();
+        }
+#    endif // SPLIT_TRANSPORT_STATS_ENABLE
 #    if SPLIT_CONNECTION_CHECK_TIMEOUT > 0
         bool connected = is_transport_connected();
         if (!connected) {
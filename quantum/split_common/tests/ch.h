@@ -0,0 +1,27 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Just enough of ChibiOS for serial_protocol.c to run its slave thread on the
+// host, see split_sim.c.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define likely(x) __builtin_expect(!!(x), 1)
+#define unlikely(x) __builtin_expect(!!(x), 0)
+
+#define HIGHPRIO 255
+
+#define THD_WORKING_AREA(name, size) uint8_t name[size]
+#define THD_FUNCTION(name, arg) void name(void *arg)
+
+typedef void (*tfunc_t)(void *arg);
+
+#define chRegSetThreadName(name) (void)(name)
+
+void *chThdCreateStatic(void *wsp, size_t size, int prio, tfunc_t pf, void *arg);
+
+void chThdSleepMicroseconds(uint32_t us);
@@ -0,0 +1,16 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// The benches include the transport headers from C++, which spells _Static_assert differently
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
+// A large split board, six rows of 20 columns per half
+#define MATRIX_ROWS 12
+#define MATRIX_COLS 20
+
+#define SPLIT_LAYER_STATE_ENABLE
+#define SPLIT_MODS_ENABLE
+#define SPLIT_TRANSPORT_STATS_ENABLE
@@ -0,0 +1,86 @@
+split_transport_sim_common_DEFS := \
+	-DSPLIT_KEYBOARD \
+	-DSPLIT_COMMON_TRANSACTIONS \
+	-DPLATFORM_SUPPORTS_SYNCHRONIZATION \
+	-DNO_PRINT \
+	-DNO_DEBUG
+split_transport_sim_common_CONFIG := \
+	$(QUANTUM_PATH)/split_common/tests/config_sim.h
+split_transport_sim_common_SRC := \
+	platforms/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/split_common/transport_stats.c \
+	$(PLATFORM_PATH)/chibios/drivers/serial_protocol.c \
+	$(QUANTUM_PATH)/split_common/tests/split_sim.c \
+	$(QUANTUM_PATH)/split_common/tests/split_transport_sim_bench.cpp
+split_transport_sim_common_INC := \
+	$(QUANTUM_PATH)/split_common \
+	$(QUANTUM_PATH)/split_common/tests \
+	$(PLATFORM_PATH)/chibios/drivers
+
+split_transport_sim_DEFS := \
+	$(split_transport_sim_common_DEFS)
+split_transport_sim_CONFIG := \
+	$(split_transport_sim_common_CONFIG)
+split_transport_sim_SRC := \
+	$(split_transport_sim_common_SRC)
+split_transport_sim_INC := \
+	$(split_transport_sim_common_INC)
+
+split_transport_sim_framed_DEFS := \
+	$(split_transport_sim_common_DEFS) \
+	-DSPLIT_TRANSPORT_FRAMED
+split_transport_sim_framed_CONFIG := \
+	$(split_transport_sim_common_CONFIG)
+split_transport_sim_framed_SRC := \
+	$(split_transport_sim_common_SRC)
+split_transport_sim_framed_INC := \
+	$(split_transport_sim_common_INC)
+
+split_transport_sim_pipelined_DEFS := \
+	$(split_transport_sim_common_DEFS) \
+	-DSERIAL_USART_FULL_DUPLEX \
+	-DSPLIT_TRANSPORT_FRAMED \
+	-DSPLIT_TRANSPORT_PIPELINED
+split_transport_sim_pipelined_CONFIG := \
+	$(split_transport_sim_common_CONFIG)
+split_transport_sim_pipelined_SRC := \
+	$(split_transport_sim_common_SRC)
+split_transport_sim_pipelined_INC := \
+	$(split_transport_sim_common_INC)
+
+split_transport_sim_delta_DEFS := \
+	$(split_transport_sim_common_DEFS) \
+	-DSPLIT_MATRIX_DELTA_ENABLE
+split_transport_sim_delta_CONFIG := \
+	$(split_transport_sim_common_CONFIG)
+split_transport_sim_delta_SRC := \
+	$(split_transport_sim_common_SRC)
+split_transport_sim_delta_INC := \
+	$(split_transport_sim_common_INC)
+
+split_transport_sim_notify_DEFS := \
+	$(split_transport_sim_common_DEFS) \
+	-DSERIAL_USART_FULL_DUPLEX \
+	-DSPLIT_MATRIX_NOTIFY_ENABLE
+split_transport_sim_notify_CONFIG := \
+	$(split_transport_sim_common_CONFIG)
+split_transport_sim_notify_SRC := \
+	$(split_transport_sim_common_SRC)
+split_transport_sim_notify_INC := \
+	$(split_transport_sim_common_INC)
+
+split_transport_sim_rpc_DEFS := \
+	$(split_transport_sim_common_DEFS) \
+	-DSPLIT_TRANSACTION_IDS_USER=USER_ECHO,USER_READ_REGIONS,USER_OLED_PAGE,USER_INDICATORS \
+	-DSPLIT_RPC_ASYNC_ENABLE
+split_transport_sim_rpc_CONFIG := \
+	$(split_transport_sim_common_CONFIG)
+split_transport_sim_rpc_SRC := \
+	$(split_transport_sim_common_SRC) \
+	$(QUANTUM_PATH)/split_common/tests/split_transport_sim_rpc.cpp
+split_transport_sim_rpc_INC := \
+	$(split_transport_sim_common_INC)
@@ -0,0 +1,504 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Host side stand-in for two split halves joined by a serial link. The slave
+// runs in a forked process, so that each half has its own shared memory, and
+// the serial protocol's slave thread runs on a pthread. Every byte on the link
+// carries the time it finishes arriving, which the receiver waits for, so the
+// baud rate and latency show up in the timings. Both directions are modelled
+// as separate wires, half-duplex links differ only in that the protocol never
+// uses both at once.
+//
+// Only POSIX APIs are used. The slave exits as soon as the master's end of
+// either socket closes, including when the master dies.
+
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "split_sim.h"
+#include "ch.h"
+#include "serial_protocol.h"
+#include "synchronization_util.h"
+#include "transport.h"
+#include "transport_stats.h"
+#include "action_util.h"
+#include "keyboard.h"
+#include "timer.h"
+
+#ifndef SERIAL_USART_TIMEOUT
+#    define SERIAL_USART_TIMEOUT 20
+#endif
+
+// How often the slave scans, which bounds how fast it notices a new matrix
+#ifndef SPLIT_SIM_SCAN_INTERVAL_US
+#    define SPLIT_SIM_SCAN_INTERVAL_US 250
+#endif
+
+#define SIM_RX_BUFFER_BYTES 4096
+
+typedef struct sim_byte_t {
+    uint64_t due_ns;
+    uint8_t  value;
+} sim_byte_t;
+
+enum sim_command_id {
+    SIM_SET_MATRIX,
+    SIM_GET_STATE,
+};
+
+typedef struct sim_command_t {
+    uint8_t      id;
+    matrix_row_t matrix[(MATRIX_ROWS) / 2];
+} sim_command_t;
+
+static split_sim_link_t link_config;
+static bool             sim_is_master = true;
+static pid_t            slave_pid     = -1;
+static int              data_fd       = -1;
+static int              control_fd    = -1;
+static uint32_t         rng_state     = 1;
+static uint64_t         tx_free_ns    = 0; // when everything sent so far has left the transmitter
+static bool             timer_held    = false;
+static uint32_t         timer_held_ms = 0;
+
+static uint8_t rx_raw[SIM_RX_BUFFER_BYTES];
+static size_t  rx_len = 0;
+static size_t  rx_pos = 0;
+
+static pthread_mutex_t shmem_mutex;
+static bool            shmem_mutex_ready = false;
+
+////////////////////////////////////////////////////
+// Helpers
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+uint64_t split_sim_now_us(void) {
+    return now_ns() / 1000;
+}
+
+static void sleep_until(uint64_t due_ns) {
+    // Sleep most of the way and spin for the rest, the scheduler is too coarse
+    // for byte times of a few microseconds
+    uint64_t now = now_ns();
+    if (due_ns > now + 200000) {
+        uint64_t        sleep = due_ns - now - 100000;
+        struct timespec ts    = {.tv_sec = sleep / 1000000000ULL, .tv_nsec = sleep % 1000000000ULL};
+        nanosleep(&ts, NULL);
+    }
+    while (now_ns() < due_ns) {
+    }
+}
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static bool rng_chance(uint32_t ppm) {
+    return ppm > 0 && (rng_next() % 1000000) < ppm;
+}
+
+static bool write_all(int fd, const void *data, size_t size) {
+    const uint8_t *p = (const uint8_t *)data;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool read_all(int fd, void *data, size_t size) {
+    uint8_t *p = (uint8_t *)data;
+    while (size > 0) {
+        ssize_t n = read(fd, p, size);
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+// Moves whatever arrived on the link into the receive buffer, waiting up to
+// timeout_ms for something to arrive, or forever for a negative timeout. A
+// full buffer overruns like a UART would, losing the oldest bytes.
+static bool rx_fill(int timeout_ms) {
+    if (rx_len - rx_pos >= sizeof(rx_raw) / 2) {
+        rx_pos += (sizeof(rx_raw) / 2 / sizeof(sim_byte_t)) * sizeof(sim_byte_t);
+    }
+    if (rx_pos > 0) {
+        memmove(rx_raw, &rx_raw[rx_pos], rx_len - rx_pos);
+        rx_len -= rx_pos;
+        rx_pos = 0;
+    }
+    struct pollfd pfd = {.fd = data_fd, .events = POLLIN};
+    if (poll(&pfd, 1, timeout_ms) <= 0) {
+        return false;
+    }
+
+    ssize_t n = read(data_fd, &rx_raw[rx_len], sizeof(rx_raw) - rx_len);
+    if (n <= 0) {
+        // The other half went away, which ends the slave
+        if (!sim_is_master) {
+            _exit(0);
+        }
+        return false;
+    }
+    rx_len += n;
+    return true;
+}
+
+static bool rx_peek(sim_byte_t *byte) {
+    if (rx_len - rx_pos < sizeof(*byte)) {
+        return false;
+    }
+    memcpy(byte, &rx_raw[rx_pos], sizeof(*byte));
+    return true;
+}
+
+// A byte that hasn't finished arriving by the deadline counts as not received
+static bool receive_byte(uint8_t *destination, bool timeout, uint64_t deadline_ns) {
+    sim_byte_t byte;
+    while (!rx_peek(&byte)) {
+        int timeout_ms = -1;
+        if (timeout) {
+            uint64_t now = now_ns();
+            if (now >= deadline_ns) {
+                return false;
+            }
+            timeout_ms = (int)((deadline_ns - now + 999999) / 1000000);
+        }
+        rx_fill(timeout_ms);
+    }
+
+    if (timeout && byte.due_ns > deadline_ns) {
+        sleep_until(deadline_ns);
+        return false;
+    }
+    sleep_until(byte.due_ns);
+    rx_pos += sizeof(byte);
+    *destination = byte.value;
+    return true;
+}
+
+////////////////////////////////////////////////////
+// Serial driver
+
+void serial_transport_driver_slave_init(void) {}
+
+void serial_transport_driver_master_init(void) {}
+
+void serial_transport_driver_clear(void) {
+    // Drop what has already arrived, bytes still on the wire stay there
+    while (rx_fill(0)) {
+    }
+    uint64_t   now = now_ns();
+    sim_byte_t byte;
+    while (rx_peek(&byte) && byte.due_ns <= now) {
+        rx_pos += sizeof(byte);
+    }
+}
+
+bool serial_transport_send(const uint8_t *source, const size_t size) {
+    sim_byte_t out[size];
+    size_t     count   = 0;
+    uint64_t   byte_ns = 10ULL * 1000000000ULL / link_config.baud;
+    uint64_t   now     = now_ns();
+
+    if (tx_free_ns < now) {
+        tx_free_ns = now;
+    }
+    memset(out, 0, sizeof(out));
+    for (size_t i = 0; i < size; i++) {
+        tx_free_ns += byte_ns;
+        if (rng_chance(link_config.drop_ppm)) {
+            continue;
+        }
+        out[count].value = source[i];
+        if (rng_chance(link_config.bit_error_ppm)) {
+            out[count].value ^= 1 << (rng_next() % 8);
+        }
+        out[count].due_ns = tx_free_ns + (uint64_t)link_config.latency_us * 1000;
+        count++;
+    }
+    return write_all(data_fd, out, count * sizeof(sim_byte_t));
+}
+
+bool serial_transport_receive(uint8_t *destination, const size_t size) {
+    uint64_t deadline = now_ns() + (uint64_t)(SERIAL_USART_TIMEOUT) * 1000000;
+    for (size_t i = 0; i < size; i++) {
+        if (!receive_byte(&destination[i], true, deadline)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool serial_transport_receive_blocking(uint8_t *destination, const size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        receive_byte(&destination[i], false, 0);
+    }
+    return true;
+}
+
+bool serial_transport_receive_nonblocking(uint8_t *destination) {
+    sim_byte_t byte;
+    if (!rx_peek(&byte)) {
+        rx_fill(0);
+    }
+    if (!rx_peek(&byte) || byte.due_ns > now_ns()) {
+        return false;
+    }
+    rx_pos += sizeof(byte);
+    *destination = byte.value;
+    return true;
+}
+
+////////////////////////////////////////////////////
+// Platform
+
+void *chThdCreateStatic(void *wsp, size_t size, int prio, tfunc_t pf, void *arg) {
+    pthread_t thread;
+    pthread_create(&thread, NULL, (void *(*)(void *))pf, arg);
+    pthread_detach(thread);
+    return NULL;
+}
+
+void chThdSleepMicroseconds(uint32_t us) {
+    sleep_until(now_ns() + (uint64_t)us * 1000);
+}
+
+void split_shared_memory_lock(void) {
+    if (pthread_mutex_lock(&shmem_mutex) != 0) {
+        abort();
+    }
+}
+
+void split_shared_memory_unlock(void) {
+    if (pthread_mutex_unlock(&shmem_mutex) != 0) {
+        abort();
+    }
+}
+
+uint32_t timer_read32(void) {
+    if (timer_held) {
+        return timer_held_ms;
+    }
+    return (uint32_t)(now_ns() / 1000000);
+}
+
+void split_sim_timer_hold(bool hold) {
+    timer_held_ms = timer_read32();
+    timer_held    = hold;
+}
+
+void split_sim_timer_advance(uint32_t ms) {
+    timer_held_ms += ms;
+}
+
+uint16_t timer_read(void) {
+    return (uint16_t)timer_read32();
+}
+
+void wait_ms(uint32_t ms) {
+    sleep_until(now_ns() + (uint64_t)ms * 1000000);
+}
+
+uint32_t split_transport_stats_timer(void) {
+    return (uint32_t)split_sim_now_us();
+}
+
+uint32_t split_transport_stats_elapsed_us(uint32_t start) {
+    return (uint32_t)split_sim_now_us() - start;
+}
+
+////////////////////////////////////////////////////
+// Keyboard state synced by the transactions
+
+layer_state_t layer_state         = 0;
+layer_state_t default_layer_state = 0;
+
+static uint8_t real_mods           = 0;
+static uint8_t weak_mods           = 0;
+static uint8_t oneshot_mods        = 0;
+static uint8_t oneshot_locked_mods = 0;
+
+uint8_t get_mods(void) {
+    return real_mods;
+}
+void set_mods(uint8_t mods) {
+    real_mods = mods;
+}
+uint8_t get_weak_mods(void) {
+    return weak_mods;
+}
+void set_weak_mods(uint8_t mods) {
+    weak_mods = mods;
+}
+uint8_t get_oneshot_mods(void) {
+    return oneshot_mods;
+}
+void set_oneshot_mods(uint8_t mods) {
+    oneshot_mods = mods;
+}
+uint8_t get_oneshot_locked_mods(void) {
+    return oneshot_locked_mods;
+}
+void set_oneshot_locked_mods(uint8_t mods) {
+    oneshot_locked_mods = mods;
+}
+
+bool is_keyboard_master(void) {
+    return sim_is_master;
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+////////////////////////////////////////////////////
+// Halves
+
+static void slave_main(void) {
+    matrix_row_t master_matrix[(MATRIX_ROWS) / 2] = {0};
+    matrix_row_t slave_matrix[(MATRIX_ROWS) / 2]  = {0};
+
+    transport_slave_init();
+
+    while (true) {
+        uint64_t      next_scan = now_ns() + SPLIT_SIM_SCAN_INTERVAL_US * 1000ULL;
+        struct pollfd pfd       = {.fd = control_fd, .events = POLLIN};
+        sim_command_t command;
+        bool          answer = false;
+
+        if (poll(&pfd, 1, 0) > 0) {
+            if (!read_all(control_fd, &command, sizeof(command))) {
+                _exit(0);
+            }
+            if (command.id == SIM_SET_MATRIX) {
+                memcpy(slave_matrix, command.matrix, sizeof(slave_matrix));
+            }
+            answer = true;
+        }
+
+        transport_slave(master_matrix, slave_matrix);
+
+        if (answer) {
+            split_sim_slave_state_t state;
+            memcpy(state.matrix, slave_matrix, sizeof(state.matrix));
+            state.layer_state = layer_state;
+            state.mods        = get_mods();
+            if (!write_all(control_fd, &state, sizeof(state))) {
+                _exit(0);
+            }
+        }
+
+        sleep_until(next_scan);
+    }
+}
+
+void split_sim_start(const split_sim_link_t *link) {
+    int data[2];
+    int control[2];
+
+    // Error checking, so that taking the lock twice fails loudly instead of hanging
+    if (!shmem_mutex_ready) {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+        pthread_mutex_init(&shmem_mutex, &attr);
+        pthread_mutexattr_destroy(&attr);
+        shmem_mutex_ready = true;
+    }
+
+    link_config = *link;
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, data) != 0 || socketpair(AF_UNIX, SOCK_STREAM, 0, control) != 0) {
+        abort();
+    }
+
+    rx_len     = 0;
+    rx_pos     = 0;
+    tx_free_ns = 0;
+
+    fflush(NULL);
+    slave_pid = fork();
+    if (slave_pid == 0) {
+        sim_is_master = false;
+        data_fd       = data[1];
+        control_fd    = control[1];
+        close(data[0]);
+        close(control[0]);
+        rng_state = (link->seed ^ 0x85EBCA6B) | 1;
+        slave_main();
+    }
+
+    sim_is_master = true;
+    data_fd       = data[0];
+    control_fd    = control[0];
+    close(data[1]);
+    close(control[1]);
+    rng_state = (link->seed ^ 0x9E3779B9) | 1;
+    transport_master_init();
+}
+
+void split_sim_stop(void) {
+    if (slave_pid <= 0) {
+        return;
+    }
+    close(data_fd);
+    close(control_fd);
+    waitpid(slave_pid, NULL, 0);
+    slave_pid = -1;
+}
+
+// The master keeps receiving while it waits, or a slave streaming into a full
+// link would never get round to answering
+static void slave_command(const sim_command_t *command, split_sim_slave_state_t *state) {
+    if (!write_all(control_fd, command, sizeof(*command))) {
+        abort();
+    }
+    while (true) {
+        struct pollfd pfd[2] = {{.fd = control_fd, .events = POLLIN}, {.fd = data_fd, .events = POLLIN}};
+        if (poll(pfd, 2, -1) <= 0) {
+            continue;
+        }
+        if (pfd[0].revents) {
+            break;
+        }
+        rx_fill(0);
+    }
+    if (!read_all(control_fd, state, sizeof(*state))) {
+        abort();
+    }
+}
+
+void split_sim_set_slave_matrix(const matrix_row_t matrix[]) {
+    sim_command_t           command = {.id = SIM_SET_MATRIX};
+    split_sim_slave_state_t state;
+    memcpy(command.matrix, matrix, sizeof(command.matrix));
+    slave_command(&command, &state);
+}
+
+void split_sim_get_slave_state(split_sim_slave_state_t *state) {
+    sim_command_t command = {.id = SIM_GET_STATE};
+    slave_command(&command, state);
+}
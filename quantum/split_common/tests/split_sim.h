@@ -0,0 +1,65 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "matrix.h"
+#include "action_layer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One direction of the serial link. Bytes take 10 bit times (8N1) each, plus
+// the fixed latency, and may be damaged or lost on the way.
+typedef struct split_sim_link_t {
+    uint32_t baud;
+    uint32_t latency_us;
+    uint32_t bit_error_ppm; // chance of a byte having one bit flipped
+    uint32_t drop_ppm;      // chance of a byte going missing
+    uint32_t seed;
+} split_sim_link_t;
+
+// What the slave half currently has, as seen from the slave
+typedef struct split_sim_slave_state_t {
+    matrix_row_t  matrix[(MATRIX_ROWS) / 2];
+    layer_state_t layer_state;
+    uint8_t       mods;
+} split_sim_slave_state_t;
+
+/**
+ * @brief Forks the slave half, which runs the transport until
+ * split_sim_stop(), and makes the calling process the master.
+ */
+void split_sim_start(const split_sim_link_t *link);
+
+void split_sim_stop(void);
+
+/**
+ * @brief Sets the slave matrix, returns once the slave has scanned it.
+ */
+void split_sim_set_slave_matrix(const matrix_row_t matrix[]);
+
+void split_sim_get_slave_state(split_sim_slave_state_t *state);
+
+// Monotonic clock shared by both halves
+uint64_t split_sim_now_us(void);
+
+/**
+ * @brief Holds timer_read32() still on the master, so that tests don't depend
+ * on how long their cycles take compared to FORCED_SYNC_THROTTLE_MS. The link
+ * itself keeps running on the real clock.
+ */
+void split_sim_timer_hold(bool hold);
+
+/**
+ * @brief Moves a held timer_read32() on by the given time.
+ */
+void split_sim_timer_advance(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
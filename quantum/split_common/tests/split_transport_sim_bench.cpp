@@ -0,0 +1,208 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+#include "split_sim.h"
+#include "transport.h"
+#include "transport_stats.h"
+#include "action_util.h"
+}
+
+#ifndef SPLIT_SIM_BENCH_CYCLES
+#    define SPLIT_SIM_BENCH_CYCLES 2000
+#endif
+
+// The slave matrix changes one key every N cycles
+#ifndef SPLIT_SIM_BENCH_KEY_INTERVAL
+#    define SPLIT_SIM_BENCH_KEY_INTERVAL 8
+#endif
+
+// A change that still hasn't arrived after this many cycles counts as lost
+#ifndef SPLIT_SIM_BENCH_KEY_TIMEOUT
+#    define SPLIT_SIM_BENCH_KEY_TIMEOUT 256
+#endif
+
+// And the master changes layer and mods every N cycles
+#ifndef SPLIT_SIM_BENCH_STATE_INTERVAL
+#    define SPLIT_SIM_BENCH_STATE_INTERVAL 64
+#endif
+
+#define SLAVE_ROWS ((MATRIX_ROWS) / 2)
+
+struct bench_result_t {
+    uint32_t cycles;
+    uint64_t elapsed_us; // inside transport_master() only
+    uint32_t key_changes;
+    uint32_t keys_seen;
+    uint32_t keys_lost;
+    uint64_t key_latency_total_us;
+    uint64_t key_latency_max_us;
+};
+
+static const char *transaction_name(uint8_t id) {
+#ifdef SPLIT_TRANSPORT_FRAMED
+    if (id == SPLIT_TRANSPORT_STATS_FRAME) {
+        return "frame";
+    }
+#endif // SPLIT_TRANSPORT_FRAMED
+    switch (id) {
+        case GET_SLAVE_MATRIX_CHECKSUM:
+            return "slave matrix checksum";
+        case GET_SLAVE_MATRIX_DATA:
+            return "slave matrix data";
+#ifdef SPLIT_MATRIX_DELTA_ENABLE
+        case GET_SLAVE_MATRIX_DELTA:
+            return "slave matrix delta";
+#endif // SPLIT_MATRIX_DELTA_ENABLE
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+        case GET_SLAVE_MATRIX_NOTIFY:
+            return "slave matrix notify";
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
+        case PUT_SYNC_TIMER:
+            return "sync timer";
+        case PUT_LAYER_STATE:
+            return "layer state";
+        case PUT_DEFAULT_LAYER_STATE:
+            return "default layer state";
+        case PUT_MODS:
+            return "mods";
+#if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+        case PUT_RPC_INFO:
+            return "rpc info";
+        case PUT_RPC_REQ_DATA:
+            return "rpc request";
+        case EXECUTE_RPC:
+            return "rpc execute";
+        case GET_RPC_RESP_DATA:
+            return "rpc response";
+#endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+        default:
+            return "other";
+    }
+}
+
+static void print_report(const char *name, const bench_result_t &result) {
+    const split_transport_link_stats_t *link = split_transport_stats_link();
+
+    printf("%-8s %6u cycles %8.0f cycles/s %7.1f us/cycle, %u failed, %u/%u keys lost, key latency avg %.0f us max %llu us\n", name, result.cycles, result.elapsed_us ? result.cycles * 1e6 / result.elapsed_us : 0.0, result.cycles ? (double)result.elapsed_us / result.cycles : 0.0, link->failed_cycles, result.keys_lost, result.key_changes, result.keys_seen ? (double)result.key_latency_total_us / result.keys_seen : 0.0, (unsigned long long)result.key_latency_max_us);
+    for (uint8_t i = 0; i < SPLIT_TRANSPORT_STATS_COUNT; i++) {
+        const split_transport_stats_t *stats = split_transport_stats_get(i);
+        if (stats->attempts == 0) {
+            continue;
+        }
+        printf("    %-22s %6u tries %4u fails %8u bytes", transaction_name(i), stats->attempts, stats->failures, stats->bytes);
+        if (stats->rtt_samples > 0) {
+            printf("  rtt avg %5u min %5u max %5u us", split_transport_stats_rtt_avg_us(stats), stats->rtt_min_us, stats->rtt_max_us);
+        }
+        printf("\n");
+    }
+}
+
+class SplitTransportSim : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[SLAVE_ROWS] = {0};
+    matrix_row_t slave_matrix[SLAVE_ROWS]  = {0};
+    matrix_row_t expected[SLAVE_ROWS]      = {0};
+
+    void TearDown() override {
+        split_sim_stop();
+    }
+
+    bench_result_t run(const split_sim_link_t &link, uint32_t cycles) {
+        bench_result_t result       = {};
+        bool           waiting      = false;
+        uint64_t       change_at    = 0;
+        uint32_t       change_cycle = 0;
+        uint32_t       step         = 0;
+
+        split_sim_start(&link);
+        split_transport_stats_reset();
+
+        for (uint32_t cycle = 0; cycle < cycles; cycle++) {
+            // Never more than one change in flight, so each latency is its own
+            if (cycle - change_cycle >= SPLIT_SIM_BENCH_KEY_INTERVAL && (!waiting || cycle - change_cycle >= SPLIT_SIM_BENCH_KEY_TIMEOUT)) {
+                if (waiting) {
+                    result.keys_lost++;
+                }
+                expected[step % SLAVE_ROWS] ^= (matrix_row_t)1 << ((step * 7) % MATRIX_COLS);
+                split_sim_set_slave_matrix(expected);
+                change_at    = split_sim_now_us();
+                change_cycle = cycle;
+                waiting      = true;
+                step++;
+                result.key_changes++;
+            }
+            if (cycle % SPLIT_SIM_BENCH_STATE_INTERVAL == 0) {
+                uint32_t state_step = cycle / SPLIT_SIM_BENCH_STATE_INTERVAL;
+                layer_state         = (layer_state_t)1 << (state_step % 8);
+                set_mods((uint8_t)state_step);
+            }
+
+            uint64_t start = split_sim_now_us();
+            transport_master(master_matrix, slave_matrix);
+            uint64_t end = split_sim_now_us();
+            result.elapsed_us += end - start;
+            result.cycles++;
+
+            if (waiting && memcmp(slave_matrix, expected, sizeof(expected)) == 0) {
+                uint64_t latency = end - change_at;
+                result.key_latency_total_us += latency;
+                if (latency > result.key_latency_max_us) {
+                    result.key_latency_max_us = latency;
+                }
+                result.keys_seen++;
+                waiting = false;
+            }
+        }
+        return result;
+    }
+
+    // Keeps the link running until both halves agree, however long that takes
+    bool converge(uint32_t max_cycles) {
+        for (uint32_t cycle = 0; cycle < max_cycles; cycle++) {
+            transport_master(master_matrix, slave_matrix);
+
+            split_sim_slave_state_t state;
+            split_sim_get_slave_state(&state);
+            if (memcmp(slave_matrix, expected, sizeof(expected)) == 0 && state.layer_state == layer_state && state.mods == get_mods()) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// The link runs against the wall clock, so a loaded host can stretch a byte
+// past SERIAL_USART_TIMEOUT. Failed cycles and lost keys are only reported;
+// what's asserted is that the halves end up in sync.
+TEST_F(SplitTransportSim, CleanLink) {
+    split_sim_link_t link   = {1000000, 0, 0, 0, 1};
+    bench_result_t   result = run(link, SPLIT_SIM_BENCH_CYCLES);
+    print_report("clean", result);
+
+    EXPECT_GT(result.keys_seen, 0u);
+    EXPECT_TRUE(converge(1000));
+}
+
+TEST_F(SplitTransportSim, LatentLink) {
+    split_sim_link_t link   = {460800, 50, 0, 0, 2};
+    bench_result_t   result = run(link, SPLIT_SIM_BENCH_CYCLES / 2);
+    print_report("latent", result);
+
+    EXPECT_GT(result.keys_seen, 0u);
+    EXPECT_TRUE(converge(1000));
+}
+
+TEST_F(SplitTransportSim, NoisyLink) {
+    split_sim_link_t link   = {1000000, 0, 1000, 200, 3};
+    bench_result_t   result = run(link, SPLIT_SIM_BENCH_CYCLES / 4);
+    print_report("noisy", result);
+
+    // Damage may cost retries and the odd key change, but never the sync
+    EXPECT_GT(result.keys_seen, 0u);
+    EXPECT_TRUE(converge(1000));
+}
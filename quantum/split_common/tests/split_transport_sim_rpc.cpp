@@ -0,0 +1,191 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+#include "split_sim.h"
+#include "transactions.h"
+#include "transport.h"
+#include "transport_stats.h"
+}
+
+#define SLAVE_ROWS ((MATRIX_ROWS) / 2)
+
+// Per-side indicator state, registered as sync regions on both halves
+static uint8_t  oled_page[8];
+static uint16_t indicators[4];
+
+struct slave_regions_t {
+    uint8_t  oled_page[8];
+    uint16_t indicators[4];
+};
+
+static void echo_slave_handler(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    const uint8_t *in  = (const uint8_t *)in_data;
+    uint8_t       *out = (uint8_t *)out_data;
+    for (uint8_t i = 0; i < in_buflen && i < out_buflen; i++) {
+        out[i] = in[i] + 1;
+    }
+}
+
+static void read_regions_slave_handler(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    slave_regions_t regions;
+    memcpy(regions.oled_page, oled_page, sizeof(oled_page));
+    memcpy(regions.indicators, indicators, sizeof(indicators));
+    memcpy(out_data, &regions, out_buflen < sizeof(regions) ? out_buflen : sizeof(regions));
+}
+
+struct echo_result_t {
+    uint8_t completions;
+    bool    success;
+    uint8_t value[4];
+};
+
+static void echo_complete(int8_t transaction_id, bool success, uint8_t target2initiator_buffer_size, const void *target2initiator_buffer, void *context) {
+    echo_result_t *result = (echo_result_t *)context;
+    result->completions++;
+    result->success = success;
+    if (success) {
+        memcpy(result->value, target2initiator_buffer, target2initiator_buffer_size);
+    }
+}
+
+static uint32_t attempts(uint8_t id) {
+    return split_transport_stats_get(id)->attempts;
+}
+
+class SplitTransportSimRpc : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[SLAVE_ROWS] = {0};
+    matrix_row_t slave_matrix[SLAVE_ROWS]  = {0};
+
+    static void SetUpTestSuite() {
+        // Before the fork, so that both halves have the same registrations
+        transaction_register_rpc(USER_ECHO, echo_slave_handler);
+        transaction_register_rpc(USER_READ_REGIONS, read_regions_slave_handler);
+        ASSERT_TRUE(transaction_register_sync_region(USER_OLED_PAGE, oled_page, sizeof(oled_page)));
+        ASSERT_TRUE(transaction_register_sync_region(USER_INDICATORS, indicators, sizeof(indicators)));
+    }
+
+    void SetUp() override {
+        split_sim_link_t link = {1000000, 0, 0, 0, 1};
+        split_sim_start(&link);
+        split_transport_stats_reset();
+        // Forced syncs only happen when a test moves the clock on
+        split_sim_timer_hold(true);
+    }
+
+    void TearDown() override {
+        split_sim_timer_hold(false);
+        split_sim_stop();
+    }
+
+    void cycles(uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            transport_master(master_matrix, slave_matrix);
+        }
+    }
+
+    bool slave_has_regions(void) {
+        slave_regions_t regions;
+        return transaction_rpc_recv(USER_READ_REGIONS, sizeof(regions), &regions) && memcmp(regions.oled_page, oled_page, sizeof(oled_page)) == 0 && memcmp(regions.indicators, indicators, sizeof(indicators)) == 0;
+    }
+};
+
+TEST_F(SplitTransportSimRpc, AsyncCallsShareOneBatch) {
+    echo_result_t results[3] = {};
+    cycles(1);
+    split_transport_stats_reset();
+
+    for (uint8_t i = 0; i < 3; i++) {
+        uint8_t request[4] = {i, (uint8_t)(i * 2), (uint8_t)(i * 3), 0xFF};
+        ASSERT_TRUE(transaction_rpc_exec_async(USER_ECHO, sizeof(request), request, sizeof(request), echo_complete, &results[i]));
+    }
+    cycles(1);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        EXPECT_EQ(results[i].completions, 1);
+        EXPECT_TRUE(results[i].success);
+        EXPECT_EQ(results[i].value[0], i + 1);
+        EXPECT_EQ(results[i].value[1], i * 2 + 1);
+        EXPECT_EQ(results[i].value[2], i * 3 + 1);
+        EXPECT_EQ(results[i].value[3], 0);
+    }
+    EXPECT_EQ(attempts(EXECUTE_RPC), 1u);
+}
+
+TEST_F(SplitTransportSimRpc, QueuedCallsAreUpdatedInPlace) {
+    echo_result_t result = {};
+    uint8_t       first  = 1;
+    uint8_t       second = 41;
+    cycles(1);
+    split_transport_stats_reset();
+
+    ASSERT_TRUE(transaction_rpc_exec_async(USER_ECHO, 1, &first, 1, echo_complete, &result));
+    ASSERT_TRUE(transaction_rpc_exec_async(USER_ECHO, 1, &second, 1, echo_complete, &result));
+    cycles(1);
+
+    EXPECT_EQ(result.completions, 1);
+    EXPECT_EQ(result.value[0], 42);
+}
+
+TEST_F(SplitTransportSimRpc, SyncRegionsOnlyWhenDirty) {
+    cycles(2);
+    EXPECT_TRUE(slave_has_regions());
+
+    // Unchanged regions cost nothing until the forced sync is due
+    split_transport_stats_reset();
+    cycles(50);
+    EXPECT_EQ(attempts(EXECUTE_RPC), 0u);
+
+    oled_page[3]  = 0x5A;
+    indicators[1] = 0x1234;
+    cycles(1);
+    EXPECT_EQ(attempts(EXECUTE_RPC), 1u);
+    EXPECT_TRUE(slave_has_regions());
+
+    // Well past FORCED_SYNC_THROTTLE_MS, both regions go out again, once
+    split_transport_stats_reset();
+    split_sim_timer_advance(1000);
+    cycles(10);
+    EXPECT_EQ(attempts(EXECUTE_RPC), 1u);
+}
+
+TEST_F(SplitTransportSimRpc, SyncRegionsBench) {
+    cycles(2);
+
+    // Blocking calls every scan, as the keymap would have to do without regions
+    split_transport_stats_reset();
+    uint64_t start = split_sim_now_us();
+    for (uint32_t i = 0; i < 500; i++) {
+        transport_master(master_matrix, slave_matrix);
+        transaction_rpc_send(USER_OLED_PAGE, sizeof(oled_page), oled_page);
+        transaction_rpc_send(USER_INDICATORS, sizeof(indicators), indicators);
+    }
+    uint64_t blocking_us = split_sim_now_us() - start;
+    uint32_t blocking    = attempts(EXECUTE_RPC);
+
+    // The same state as sync regions, changing every 16 scans
+    split_transport_stats_reset();
+    start = split_sim_now_us();
+    for (uint32_t i = 0; i < 500; i++) {
+        if (i % 16 == 0) {
+            oled_page[i % sizeof(oled_page)]++;
+            indicators[i % 4] ^= (uint16_t)i;
+        }
+        transport_master(master_matrix, slave_matrix);
+    }
+    uint64_t regions_us = split_sim_now_us() - start;
+    uint32_t batched    = attempts(EXECUTE_RPC);
+
+    printf("blocking %6.1f us/scan, %u calls\n", (double)blocking_us / 500, blocking);
+    printf("regions  %6.1f us/scan, %u calls\n", (double)regions_us / 500, batched);
+
+    EXPECT_GE(blocking, 1000u);
+    // One batch per change, the held clock never makes a forced sync due
+    EXPECT_EQ(batched, 500u / 16 + 1);
+    EXPECT_TRUE(slave_has_regions());
+}
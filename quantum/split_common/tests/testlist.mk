@@ -0,0 +1,10 @@
+# The simulator forks the slave half, which native Windows toolchains can't do
+ifneq ($(OS),Windows_NT)
+TEST_LIST += \
+	split_transport_sim \
+	split_transport_sim_framed \
+	split_transport_sim_pipelined \
+	split_transport_sim_delta \
+	split_transport_sim_notify \
+	split_transport_sim_rpc
+endif
@@ -24,6 +24,14 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_MATRIX_DELTA_ENABLE
+    GET_SLAVE_MATRIX_DELTA,
+#endif // SPLIT_MATRIX_DELTA_ENABLE
+
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+    GET_SLAVE_MATRIX_NOTIFY,
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -123,3 +131,8 @@ enum serial_transaction_id {
 
 // Ensure we only use 5 bits for transaction
 _Static_assert(NUM_TOTAL_TRANSACTIONS <= (1 << 5), "Max number of usable transactions exceeded");
+
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+// Transactions the slave may push to the master unasked, as a bitmask of ids
+#    define SPLIT_NOTIFY_TRANSACTIONS (1UL << GET_SLAVE_MATRIX_NOTIFY)
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
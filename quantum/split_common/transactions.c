@@ -178,15 +178,179 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_DELTA_ENABLE
+
+// Polls the slave's matrix checksum, and only once that changed reads the
+// slave's latest change and applies it on top of the last known matrix. Falls
+// back to a full read when a change went missing, didn't fit into a single
+// delta, or the forced sync is due.
+static bool read_matrix_delta(uint32_t *last_update, matrix_row_t destination[], const matrix_row_t last_matrix[]) {
+    static bool                synced        = false;
+    static uint8_t             last_sequence = 0;
+    split_slave_matrix_delta_t delta;
+    uint8_t                    checksum;
+    const size_t               length = sizeof(split_shmem->smatrix.matrix);
+
+    if (!transport_read(GET_SLAVE_MATRIX_CHECKSUM, &checksum, sizeof(checksum))) {
+        return false;
+    }
+
+    memcpy(destination, last_matrix, length);
+    bool full       = !synced || timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS;
+    bool have_delta = false;
+    if (!full) {
+        // An unchanged matrix costs no more than the plain checksum poll
+        if (checksum == crc8(last_matrix, length)) {
+            return true;
+        }
+        if (!transport_read(GET_SLAVE_MATRIX_DELTA, &delta, sizeof(delta))) {
+            return false;
+        }
+        // The slave may have moved on since the checksum was read
+        checksum   = delta.checksum;
+        have_delta = true;
+
+        if (delta.sequence != last_sequence) {
+            uint8_t count = 0;
+            for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+                if (delta.changed[row / 8] & (1 << (row % 8))) {
+                    if (count < SPLIT_MATRIX_DELTA_ROWS) {
+                        destination[row] = delta.rows[count];
+                    }
+                    count++;
+                }
+            }
+            full = delta.sequence != (uint8_t)(last_sequence + 1) || count > SPLIT_MATRIX_DELTA_ROWS;
+        }
+    }
+
+    // Also catches the halves drifting apart, e.g. after the slave restarted
+    if (full || crc8(destination, length) != checksum) {
+        if (!transport_read(GET_SLAVE_MATRIX_DATA, destination, length) || crc8(destination, length) != checksum) {
+            return false;
+        }
+        *last_update = timer_read32();
+    }
+
+    // Without a delta the sequence is unknown, so the next change is read in
+    // full and picks it up again
+    synced = true;
+    if (have_delta) {
+        last_sequence = delta.sequence;
+    }
+    return true;
+}
+
+// Records the change against the previous scan, which is still in shmem
+static void slave_matrix_update_delta(matrix_row_t slave_matrix[]) {
+    split_slave_matrix_delta_t *delta = &split_shmem->smatrix_delta;
+    uint8_t                     changed[sizeof(delta->changed)];
+    uint8_t                     count = 0;
+
+    memset(changed, 0, sizeof(changed));
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+        if (slave_matrix[row] != split_shmem->smatrix.matrix[row]) {
+            changed[row / 8] |= 1 << (row % 8);
+            if (count < SPLIT_MATRIX_DELTA_ROWS) {
+                delta->rows[count] = slave_matrix[row];
+            }
+            count++;
+        }
+    }
+    if (count > 0) {
+        memcpy(delta->changed, changed, sizeof(changed));
+        delta->sequence++;
+    }
+}
+
+#endif // SPLIT_MATRIX_DELTA_ENABLE
+
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+
+#    ifndef SPLIT_MATRIX_NOTIFY_HEARTBEAT_MS
+#        define SPLIT_MATRIX_NOTIFY_HEARTBEAT_MS 50
+#    endif // SPLIT_MATRIX_NOTIFY_HEARTBEAT_MS
+
+static bool slave_matrix_resync = true;
+
+// Applies a pushed change to the last known matrix, returns false if one went missing
+static bool slave_matrix_apply_notify(matrix_row_t last_matrix[]) {
+    static uint8_t last_sequence = 0;
+    bool           dropped       = false;
+
+    if (transport_notifications(&dropped) & (1UL << GET_SLAVE_MATRIX_NOTIFY)) {
+        const split_slave_matrix_notify_t *notify = &split_shmem->smatrix_notify;
+        if (notify->sequence != (uint8_t)(last_sequence + 1)) {
+            dropped = true;
+        }
+        last_sequence = notify->sequence;
+
+        uint8_t count = 0;
+        for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+            if (notify->changed[row / 8] & (1 << (row % 8))) {
+                last_matrix[row] = notify->rows[count++];
+            }
+        }
+    }
+    return !dropped;
+}
+
+static void slave_matrix_send_notify(matrix_row_t slave_matrix[]) {
+    static matrix_row_t last_notified[(MATRIX_ROWS) / 2] = {0};
+    static uint8_t      sequence                         = 0;
+
+    split_slave_matrix_notify_t *notify = &split_shmem->smatrix_notify;
+    uint8_t                      count  = 0;
+    memset(notify->changed, 0, sizeof(notify->changed));
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+        if (slave_matrix[row] != last_notified[row]) {
+            notify->changed[row / 8] |= 1 << (row % 8);
+            notify->rows[count++] = slave_matrix[row];
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+
+    // A notification that doesn't make it shows up as a sequence gap on the master
+    notify->sequence = ++sequence;
+    if (transport_notify(GET_SLAVE_MATRIX_NOTIFY, offsetof(split_slave_matrix_notify_t, rows) + count * sizeof(matrix_row_t))) {
+        memcpy(last_notified, slave_matrix, sizeof(last_notified));
+    }
+}
+
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
     matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];       // holding area while we test whether or not checksum is correct
 
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+    // The slave pushes its changes as they happen, so polling is only needed
+    // as a heartbeat, or to catch up after a notification went missing
+    static uint32_t last_poll = 0;
+    if (!slave_matrix_apply_notify(last_matrix)) {
+        slave_matrix_resync = true;
+    }
+    if (!slave_matrix_resync && timer_elapsed32(last_poll) < SPLIT_MATRIX_NOTIFY_HEARTBEAT_MS) {
+        memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+        return true;
+    }
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
+#ifdef SPLIT_MATRIX_DELTA_ENABLE
+    bool okay = read_matrix_delta(&last_update, temp_matrix, last_matrix);
+#else  // SPLIT_MATRIX_DELTA_ENABLE
     bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+#endif // SPLIT_MATRIX_DELTA_ENABLE
     if (okay) {
         // Checksum matches the received data, save as the last matrix state
         memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+        last_poll           = timer_read32();
+        slave_matrix_resync = false;
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
     }
     // Copy out the last-known-good matrix state to the slave matrix
     memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
@@ -194,16 +358,39 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
 }
 
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_MATRIX_DELTA_ENABLE
+    slave_matrix_update_delta(slave_matrix);
+#endif // SPLIT_MATRIX_DELTA_ENABLE
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+#ifdef SPLIT_MATRIX_DELTA_ENABLE
+    split_shmem->smatrix_delta.checksum = split_shmem->smatrix.checksum;
+#endif // SPLIT_MATRIX_DELTA_ENABLE
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+    slave_matrix_send_notify(slave_matrix);
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
 }
 
+#ifdef SPLIT_MATRIX_DELTA_ENABLE
+#    define TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS [GET_SLAVE_MATRIX_DELTA] = trans_target2initiator_initializer(smatrix_delta),
+#else // SPLIT_MATRIX_DELTA_ENABLE
+#    define TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS
+#endif // SPLIT_MATRIX_DELTA_ENABLE
+
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+#    define TRANSACTIONS_SLAVE_MATRIX_NOTIFY_REGISTRATIONS [GET_SLAVE_MATRIX_NOTIFY] = trans_target2initiator_initializer(smatrix_notify),
+#else // SPLIT_MATRIX_NOTIFY_ENABLE
+#    define TRANSACTIONS_SLAVE_MATRIX_NOTIFY_REGISTRATIONS
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
 // clang-format off
 #define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
-    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix), \
+    TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS \
+    TRANSACTIONS_SLAVE_MATRIX_NOTIFY_REGISTRATIONS
 // clang-format on
 
 ////////////////////////////////////////////////////
@@ -914,6 +1101,174 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Asynchronous RPC
+
+#ifdef SPLIT_RPC_ASYNC_ENABLE
+#    if !defined(SPLIT_TRANSACTION_IDS_KB) && !defined(SPLIT_TRANSACTION_IDS_USER)
+#        error "SPLIT_RPC_ASYNC_ENABLE requires SPLIT_TRANSACTION_IDS_KB or SPLIT_TRANSACTION_IDS_USER"
+#    endif
+
+typedef struct _rpc_async_request_t {
+    rpc_batch_entry_t    entry;
+    split_rpc_complete_t callback;
+    void                *context;
+    uint8_t              m2s_buffer[RPC_ASYNC_M2S_BUFFER_SIZE];
+} rpc_async_request_t;
+
+typedef struct _rpc_sync_region_t {
+    int8_t   transaction_id;
+    uint8_t  size;
+    bool     synced;
+    uint8_t  checksum;
+    uint8_t  pending_checksum;
+    uint32_t last_sync;
+    void    *data;
+} rpc_sync_region_t;
+
+static rpc_async_request_t rpc_queue[SPLIT_RPC_QUEUE_SIZE];
+static uint8_t             rpc_queue_count = 0;
+// Requests at the front of the queue that are in flight, and can't be updated
+static uint8_t rpc_queue_sending = 0;
+
+static rpc_sync_region_t rpc_sync_regions[SPLIT_RPC_SYNC_REGIONS];
+static uint8_t           rpc_sync_region_count = 0;
+
+static void rpc_async_complete(uint8_t count, bool success, const uint8_t *s2m_buffer) {
+    rpc_queue_sending = count;
+    for (uint8_t i = 0; i < count; i++) {
+        rpc_async_request_t *request = &rpc_queue[i];
+        if (request->callback) {
+            request->callback(request->entry.transaction_id, success, request->entry.s2m_length, s2m_buffer, request->context);
+        }
+        if (s2m_buffer) {
+            s2m_buffer += request->entry.s2m_length;
+        }
+    }
+    // Callbacks may have queued more requests behind the completed ones
+    rpc_queue_count -= count;
+    memmove(&rpc_queue[0], &rpc_queue[count], rpc_queue_count * sizeof(rpc_async_request_t));
+    rpc_queue_sending = 0;
+}
+
+static void rpc_sync_region_complete(int8_t transaction_id, bool success, uint8_t target2initiator_buffer_size, const void *target2initiator_buffer, void *context) {
+    rpc_sync_region_t *region = (rpc_sync_region_t *)context;
+    region->synced            = success;
+    if (success) {
+        region->checksum  = region->pending_checksum;
+        region->last_sync = timer_read32();
+    }
+}
+
+static void rpc_sync_regions_update(void) {
+    for (uint8_t i = 0; i < rpc_sync_region_count; i++) {
+        rpc_sync_region_t *region   = &rpc_sync_regions[i];
+        uint8_t            checksum = crc8(region->data, region->size);
+        if (region->synced && checksum == region->checksum && timer_elapsed32(region->last_sync) < FORCED_SYNC_THROTTLE_MS) {
+            continue;
+        }
+        if (transaction_rpc_exec_async(region->transaction_id, region->size, region->data, 0, rpc_sync_region_complete, region)) {
+            region->pending_checksum = checksum;
+        }
+    }
+}
+
+static bool rpc_async_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    rpc_sync_regions_update();
+    if (rpc_queue_count == 0) {
+        return true;
+    }
+    if (!is_transport_connected()) {
+        rpc_async_complete(rpc_queue_count, false, NULL);
+        return true;
+    }
+
+    // Pack as many queued requests as fit into one batch
+    uint8_t m2s_batch[RPC_M2S_BUFFER_SIZE];
+    uint8_t s2m_batch[RPC_S2M_BUFFER_SIZE];
+    uint8_t m2s_length = 0;
+    uint8_t s2m_length = 0;
+    uint8_t count      = 0;
+    while (count < rpc_queue_count) {
+        const rpc_async_request_t *request = &rpc_queue[count];
+        if (m2s_length + sizeof(rpc_batch_entry_t) + request->entry.m2s_length > RPC_M2S_BUFFER_SIZE || s2m_length + request->entry.s2m_length > RPC_S2M_BUFFER_SIZE) {
+            break;
+        }
+        memcpy(&m2s_batch[m2s_length], &request->entry, sizeof(rpc_batch_entry_t));
+        memcpy(&m2s_batch[m2s_length + sizeof(rpc_batch_entry_t)], request->m2s_buffer, request->entry.m2s_length);
+        m2s_length += sizeof(rpc_batch_entry_t) + request->entry.m2s_length;
+        s2m_length += request->entry.s2m_length;
+        count++;
+    }
+
+    if (!transaction_rpc_exec(RPC_BATCH_TRANSACTION_ID, m2s_length, m2s_batch, s2m_length, s2m_batch)) {
+        // Everything stays queued, a retry may run some calls twice
+        return false;
+    }
+    rpc_async_complete(count, true, s2m_batch);
+    return true;
+}
+
+static void rpc_async_exec_batch_slave(uint8_t m2s_length, const uint8_t *m2s_batch, uint8_t s2m_length, uint8_t *s2m_batch) {
+    uint8_t m2s_offset = 0;
+    uint8_t s2m_offset = 0;
+    while (m2s_offset + sizeof(rpc_batch_entry_t) <= m2s_length) {
+        rpc_batch_entry_t entry;
+        memcpy(&entry, &m2s_batch[m2s_offset], sizeof(entry));
+        m2s_offset += sizeof(entry);
+        if (m2s_offset + entry.m2s_length > m2s_length || s2m_offset + entry.s2m_length > s2m_length) {
+            return;
+        }
+
+        const uint8_t *m2s_buffer = &m2s_batch[m2s_offset];
+        uint8_t       *s2m_buffer = &s2m_batch[s2m_offset];
+        m2s_offset += entry.m2s_length;
+        s2m_offset += entry.s2m_length;
+
+        bool handled = false;
+        for (uint8_t i = 0; i < rpc_sync_region_count; i++) {
+            rpc_sync_region_t *region = &rpc_sync_regions[i];
+            if (region->transaction_id == entry.transaction_id && region->size == entry.m2s_length) {
+                memcpy(region->data, m2s_buffer, region->size);
+                handled = true;
+                break;
+            }
+        }
+        if (!handled && entry.transaction_id > GET_RPC_RESP_DATA && entry.transaction_id < NUM_TOTAL_TRANSACTIONS) {
+            split_transaction_desc_t *trans = &split_transaction_table[entry.transaction_id];
+            if (trans->slave_callback) {
+                trans->slave_callback(entry.m2s_length, m2s_buffer, entry.s2m_length, s2m_buffer);
+            }
+        }
+    }
+}
+
+#    define TRANSACTIONS_RPC_ASYNC_MASTER() TRANSACTION_HANDLER_MASTER(rpc_async)
+
+#else // SPLIT_RPC_ASYNC_ENABLE
+
+#    define TRANSACTIONS_RPC_ASYNC_MASTER()
+
+#endif // SPLIT_RPC_ASYNC_ENABLE
+
+////////////////////////////////////////////////////
+// Frame flush
+
+#ifdef SPLIT_TRANSPORT_FRAMED
+
+static bool frame_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Send whatever writes are still queued after the last read
+    return transport_frame_flush();
+}
+
+#    define TRANSACTIONS_FRAME_MASTER() TRANSACTION_HANDLER_MASTER(frame)
+
+#else // SPLIT_TRANSPORT_FRAMED
+
+#    define TRANSACTIONS_FRAME_MASTER()
+
+#endif // SPLIT_TRANSPORT_FRAMED
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -974,6 +1329,8 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_RPC_ASYNC_MASTER();
+    TRANSACTIONS_FRAME_MASTER();
     return true;
 }
 
@@ -1017,7 +1374,11 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
         return false;
     }
     // Prevent invoking RPC on QMK core sync data
+#    ifdef SPLIT_RPC_ASYNC_ENABLE
+    if (transaction_id <= GET_RPC_RESP_DATA && transaction_id != RPC_BATCH_TRANSACTION_ID) return false;
+#    else
     if (transaction_id <= GET_RPC_RESP_DATA) return false;
+#    endif // SPLIT_RPC_ASYNC_ENABLE
     // Prevent sizing issues
     if (initiator2target_buffer_size > RPC_M2S_BUFFER_SIZE) return false;
     if (target2initiator_buffer_size > RPC_S2M_BUFFER_SIZE) return false;
@@ -1050,6 +1411,53 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     return true;
 }
 
+#    ifdef SPLIT_RPC_ASYNC_ENABLE
+
+bool transaction_rpc_exec_async(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, split_rpc_complete_t callback, void *context) {
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id <= GET_RPC_RESP_DATA) return false;
+    // Prevent sizing issues, each call has to fit into a batch on its own
+    if (initiator2target_buffer_size > RPC_ASYNC_M2S_BUFFER_SIZE) return false;
+    if (target2initiator_buffer_size > RPC_S2M_BUFFER_SIZE) return false;
+
+    rpc_async_request_t *request = NULL;
+    for (uint8_t i = rpc_queue_sending; i < rpc_queue_count; i++) {
+        if (rpc_queue[i].entry.transaction_id == transaction_id && rpc_queue[i].callback == callback && rpc_queue[i].context == context) {
+            request = &rpc_queue[i];
+            break;
+        }
+    }
+    if (!request) {
+        if (rpc_queue_count >= SPLIT_RPC_QUEUE_SIZE) {
+            return false;
+        }
+        request = &rpc_queue[rpc_queue_count++];
+    }
+
+    request->entry.transaction_id = transaction_id;
+    request->entry.m2s_length     = initiator2target_buffer_size;
+    request->entry.s2m_length     = target2initiator_buffer_size;
+    request->callback             = callback;
+    request->context              = context;
+    memcpy(request->m2s_buffer, initiator2target_buffer, initiator2target_buffer_size);
+    return true;
+}
+
+bool transaction_register_sync_region(int8_t transaction_id, void *data, uint8_t size) {
+    if (transaction_id <= GET_RPC_RESP_DATA) return false;
+    if (size > RPC_ASYNC_M2S_BUFFER_SIZE) return false;
+    if (rpc_sync_region_count >= SPLIT_RPC_SYNC_REGIONS) return false;
+
+    rpc_sync_region_t *region = &rpc_sync_regions[rpc_sync_region_count++];
+    region->transaction_id    = transaction_id;
+    region->size              = size;
+    region->synced            = false;
+    region->data              = data;
+    return true;
+}
+
+#    endif // SPLIT_RPC_ASYNC_ENABLE
+
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
     // The RPC info block contains the intended transaction ID, as well as the sizes for both inbound and outbound data.
     // Ignore the args -- the `split_shmem` already has the info, we just need to act upon it.
@@ -1068,7 +1476,13 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
     }
 
     int8_t transaction_id = split_shmem->rpc_info.payload.transaction_id;
-    if (transaction_id < NUM_TOTAL_TRANSACTIONS) {
+#    ifdef SPLIT_RPC_ASYNC_ENABLE
+    if (transaction_id == RPC_BATCH_TRANSACTION_ID) {
+        rpc_async_exec_batch_slave(split_shmem->rpc_info.payload.m2s_length, split_shmem->rpc_m2s_buffer, split_shmem->rpc_info.payload.s2m_length, split_shmem->rpc_s2m_buffer);
+        return;
+    }
+#    endif // SPLIT_RPC_ASYNC_ENABLE
+    if (transaction_id >= 0 && transaction_id < NUM_TOTAL_TRANSACTIONS) {
         split_transaction_desc_t *trans = &split_transaction_table[transaction_id];
         if (trans->slave_callback) {
             trans->slave_callback(split_shmem->rpc_info.payload.m2s_length, split_shmem->rpc_m2s_buffer, split_shmem->rpc_info.payload.s2m_length, split_shmem->rpc_s2m_buffer);
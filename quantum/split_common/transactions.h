@@ -51,3 +51,19 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
 
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
+
+#ifdef SPLIT_RPC_ASYNC_ENABLE
+// Called on the master once an asynchronous RPC has run on the slave, or has
+// been given up on because the transport is disconnected. The response buffer
+// is only valid for the duration of the call.
+typedef void (*split_rpc_complete_t)(int8_t transaction_id, bool success, uint8_t target2initiator_buffer_size, const void *target2initiator_buffer, void *context);
+
+// Queues an RPC for the next transport cycle, which sends everything queued as
+// one batch. The request data is copied. A call that is still queued with the
+// same id, callback and context is updated in place instead.
+bool transaction_rpc_exec_async(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, split_rpc_complete_t callback, void *context);
+
+// Registered on both halves, the master sends the region to the slave's copy
+// whenever it changes, and otherwise only every FORCED_SYNC_THROTTLE_MS.
+bool transaction_register_sync_region(int8_t transaction_id, void *data, uint8_t size);
+#endif // SPLIT_RPC_ASYNC_ENABLE
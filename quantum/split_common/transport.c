@@ -22,6 +22,10 @@
 #include "transaction_id_define.h"
 #include "atomic_util.h"
 
+#ifdef SPLIT_TRANSPORT_STATS_ENABLE
+#    include "transport_stats.h"
+#endif
+
 #ifdef USE_I2C
 
 #    ifndef SLAVE_I2C_TIMEOUT
@@ -35,6 +39,10 @@
 #    include "i2c_master.h"
 #    include "i2c_slave.h"
 
+#    if defined(SPLIT_TRANSPORT_FRAMED) || defined(SPLIT_MATRIX_NOTIFY_ENABLE)
+#        error "SPLIT_TRANSPORT_FRAMED and SPLIT_MATRIX_NOTIFY_ENABLE are only supported by the serial transport"
+#    endif
+
 // Ensure the I2C buffer has enough space
 _Static_assert(sizeof(split_shared_memory_t) <= I2C_SLAVE_REG_COUNT, "split_shared_memory_t too large for I2C_SLAVE_REG_COUNT");
 
@@ -59,7 +67,7 @@ i2c_status_t transport_trigger_callback(int8_t id) {
     return i2c_write_register(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, SLAVE_I2C_TIMEOUT);
 }
 
-bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+static bool transport_execute_i2c_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     i2c_status_t              status;
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
@@ -86,6 +94,17 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+#    ifdef SPLIT_TRANSPORT_STATS_ENABLE
+    uint32_t start = split_transport_stats_timer();
+    bool     okay  = transport_execute_i2c_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    split_transport_stats_record(id, okay, initiator2target_length + target2initiator_length, split_transport_stats_elapsed_us(start));
+    return okay;
+#    else
+    return transport_execute_i2c_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+#    endif // SPLIT_TRANSPORT_STATS_ENABLE
+}
+
 #else // USE_I2C
 
 #    include "serial.h"
@@ -100,6 +119,119 @@ void transport_slave_init(void) {
     soft_serial_target_init();
 }
 
+static bool transport_serial_transaction(int8_t id) {
+#    ifdef SPLIT_TRANSPORT_STATS_ENABLE
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    uint32_t                  start = split_transport_stats_timer();
+    bool                      okay  = soft_serial_transaction(id);
+    split_transport_stats_record(id, okay, trans->initiator2target_buffer_size + trans->target2initiator_buffer_size, split_transport_stats_elapsed_us(start));
+    return okay;
+#    else
+    return soft_serial_transaction(id);
+#    endif // SPLIT_TRANSPORT_STATS_ENABLE
+}
+
+#    ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+#        ifdef SERIAL_DRIVER_BITBANG
+#            error "SPLIT_MATRIX_NOTIFY_ENABLE is not supported by the bitbang serial driver"
+#        endif
+
+bool transport_notify(int8_t id, uint8_t length) {
+    return soft_serial_target_notify(id, length);
+}
+
+uint32_t transport_notifications(bool *dropped) {
+    return soft_serial_initiator_notifications(dropped);
+}
+#    endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
+#    ifdef SPLIT_TRANSPORT_FRAMED
+#        ifdef SERIAL_DRIVER_BITBANG
+#            error "SPLIT_TRANSPORT_FRAMED is not supported by the bitbang serial driver"
+#        endif
+
+static bool    frame_open  = false;
+static uint8_t frame_count = 0;
+static uint8_t frame_ids[NUM_TOTAL_TRANSACTIONS];
+
+void transport_frame_begin(void) {
+    frame_open = true;
+}
+
+void transport_frame_end(void) {
+    // Anything still queued is kept and goes out with the next frame
+    frame_open = false;
+}
+
+bool transport_frame_flush(void) {
+    if (frame_count == 0) {
+        return true;
+    }
+
+    // A lone transaction is cheaper without the frame header
+    if (frame_count == 1) {
+        bool okay = transport_serial_transaction(frame_ids[0]);
+        if (okay) {
+            frame_count = 0;
+        }
+        return okay;
+    }
+
+#        ifdef SPLIT_TRANSPORT_STATS_ENABLE
+    uint32_t start = split_transport_stats_timer();
+#        endif // SPLIT_TRANSPORT_STATS_ENABLE
+
+    bool okay = soft_serial_transaction_frame(frame_ids, frame_count);
+
+#        ifdef SPLIT_TRANSPORT_STATS_ENABLE
+    uint32_t rtt   = split_transport_stats_elapsed_us(start);
+    uint16_t bytes = 0;
+    for (uint8_t i = 0; i < frame_count; i++) {
+        split_transaction_desc_t *trans = &split_transaction_table[frame_ids[i]];
+        split_transport_stats_record(frame_ids[i], okay, trans->initiator2target_buffer_size + trans->target2initiator_buffer_size, SPLIT_TRANSPORT_STATS_UNTIMED);
+        bytes += trans->initiator2target_buffer_size + trans->target2initiator_buffer_size;
+    }
+    split_transport_stats_record(SPLIT_TRANSPORT_STATS_FRAME, okay, bytes, rtt);
+#        endif // SPLIT_TRANSPORT_STATS_ENABLE
+
+    if (okay) {
+        frame_count = 0;
+    }
+    return okay;
+}
+
+static inline bool transport_frame_queueable(int8_t id) {
+#        if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    // RPC transactions resize their buffers on the slave as they go, so they
+    // can't share a frame whose payload lengths are fixed up front.
+    if (id >= PUT_RPC_INFO && id <= GET_RPC_RESP_DATA) {
+        return false;
+    }
+#        endif
+    return frame_open;
+}
+
+static bool transport_frame_queue(int8_t id, bool needs_response) {
+    bool queued = memchr(frame_ids, id, frame_count) != NULL;
+    if (!queued) {
+        frame_ids[frame_count++] = id;
+    }
+
+    if (!needs_response) {
+        return true;
+    }
+
+    if (!transport_frame_flush()) {
+        // Keep the queued writes for a retry, but drop the read that failed
+        if (!queued) {
+            frame_count--;
+        }
+        return false;
+    }
+    return true;
+}
+#    endif // SPLIT_TRANSPORT_FRAMED
+
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
@@ -107,9 +239,19 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
     }
 
-    if (!soft_serial_transaction(id)) {
+#    ifdef SPLIT_TRANSPORT_FRAMED
+    if (transport_frame_queueable(id)) {
+        if (!transport_frame_queue(id, target2initiator_length > 0)) {
+            return false;
+        }
+    } else if (!transport_frame_flush() || !transport_serial_transaction(id)) {
+        return false;
+    }
+#    else
+    if (!transport_serial_transaction(id)) {
         return false;
     }
+#    endif // SPLIT_TRANSPORT_FRAMED
 
     if (target2initiator_length > 0) {
         size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
@@ -122,7 +264,14 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSPORT_FRAMED
+    transport_frame_begin();
+    bool okay = transactions_master(master_matrix, slave_matrix);
+    transport_frame_end();
+    return okay;
+#else
     return transactions_master(master_matrix, slave_matrix);
+#endif
 }
 
 void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
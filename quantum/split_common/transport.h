@@ -31,6 +31,15 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifdef SPLIT_RPC_ASYNC_ENABLE
+#    ifndef SPLIT_RPC_QUEUE_SIZE
+#        define SPLIT_RPC_QUEUE_SIZE 4
+#    endif // SPLIT_RPC_QUEUE_SIZE
+#    ifndef SPLIT_RPC_SYNC_REGIONS
+#        define SPLIT_RPC_SYNC_REGIONS 4
+#    endif // SPLIT_RPC_SYNC_REGIONS
+#endif // SPLIT_RPC_ASYNC_ENABLE
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -40,6 +49,21 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+// Slave: push a target2initiator buffer to the master without being polled
+bool transport_notify(int8_t id, uint8_t length);
+// Master: bitmask of transaction ids updated by the slave since the last call
+uint32_t transport_notifications(bool *dropped);
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
+#ifdef SPLIT_TRANSPORT_FRAMED
+// While a frame is open, write-only transactions are queued and sent together
+// with the next read, or on an explicit flush, as a single framed exchange.
+void transport_frame_begin(void);
+bool transport_frame_flush(void);
+void transport_frame_end(void);
+#endif // SPLIT_TRANSPORT_FRAMED
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -57,6 +81,30 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_MATRIX_DELTA_ENABLE
+#    ifndef SPLIT_MATRIX_DELTA_ROWS
+#        define SPLIT_MATRIX_DELTA_ROWS 1
+#    endif // SPLIT_MATRIX_DELTA_ROWS
+
+// Change of the slave matrix from `sequence - 1` to `sequence`. When more rows
+// changed than fit into `rows`, only `changed` is valid.
+typedef struct _split_slave_matrix_delta_t {
+    uint8_t      sequence;
+    uint8_t      checksum; // crc8 of the whole matrix as of `sequence`
+    uint8_t      changed[((MATRIX_ROWS) / 2 + 7) / 8];
+    matrix_row_t rows[SPLIT_MATRIX_DELTA_ROWS];
+} split_slave_matrix_delta_t;
+#endif // SPLIT_MATRIX_DELTA_ENABLE
+
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+// Only the rows flagged in `changed` are sent, packed at the start of `rows`
+typedef struct _split_slave_matrix_notify_t {
+    uint8_t      sequence;
+    uint8_t      changed[((MATRIX_ROWS) / 2 + 7) / 8];
+    matrix_row_t rows[(MATRIX_ROWS) / 2];
+} split_slave_matrix_notify_t;
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -141,6 +189,21 @@ typedef struct _rpc_sync_info_t {
         uint8_t s2m_length;
     } payload;
 } rpc_sync_info_t;
+
+#    ifdef SPLIT_RPC_ASYNC_ENABLE
+// A batch is sent as a single RPC to this id, its request data holding each
+// call's header followed by that call's request data, back to back. The
+// response data holds each call's response, in the same order.
+#        define RPC_BATCH_TRANSACTION_ID (-1)
+
+typedef struct _rpc_batch_entry_t {
+    int8_t  transaction_id;
+    uint8_t m2s_length;
+    uint8_t s2m_length;
+} rpc_batch_entry_t;
+
+#        define RPC_ASYNC_M2S_BUFFER_SIZE (RPC_M2S_BUFFER_SIZE - sizeof(rpc_batch_entry_t))
+#    endif // SPLIT_RPC_ASYNC_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
@@ -154,6 +217,14 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_MATRIX_DELTA_ENABLE
+    split_slave_matrix_delta_t smatrix_delta;
+#endif // SPLIT_MATRIX_DELTA_ENABLE
+
+#ifdef SPLIT_MATRIX_NOTIFY_ENABLE
+    split_slave_matrix_notify_t smatrix_notify;
+#endif // SPLIT_MATRIX_NOTIFY_ENABLE
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
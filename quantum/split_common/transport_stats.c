@@ -0,0 +1,171 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "transport_stats.h"
+#include "timer.h"
+#include "print.h"
+
+#ifdef PROTOCOL_CHIBIOS
+#    include <ch.h>
+#endif
+
+#if defined(RAW_ENABLE)
+#    include "raw_hid.h"
+#endif
+
+#ifdef SPLIT_TRANSPORT_STATS_ENABLE
+
+static split_transport_stats_t      transport_stats[SPLIT_TRANSPORT_STATS_COUNT];
+static split_transport_link_stats_t link_stats;
+static bool                         last_failed[SPLIT_TRANSPORT_STATS_COUNT];
+
+const split_transport_stats_t *split_transport_stats_get(uint8_t index) {
+    if (index >= SPLIT_TRANSPORT_STATS_COUNT) {
+        return NULL;
+    }
+    return &transport_stats[index];
+}
+
+const split_transport_link_stats_t *split_transport_stats_link(void) {
+    return &link_stats;
+}
+
+uint16_t split_transport_stats_rtt_avg_us(const split_transport_stats_t *stats) {
+    return stats->rtt_samples ? stats->rtt_total_us / stats->rtt_samples : 0;
+}
+
+void split_transport_stats_reset(void) {
+    memset(transport_stats, 0, sizeof(transport_stats));
+    memset(&link_stats, 0, sizeof(link_stats));
+    memset(last_failed, 0, sizeof(last_failed));
+}
+
+// The ChibiOS system tick is usually much finer than the millisecond timer,
+// other platforms can provide a finer clock by replacing both of these
+__attribute__((weak)) uint32_t split_transport_stats_timer(void) {
+#    ifdef PROTOCOL_CHIBIOS
+    return (uint32_t)chVTGetSystemTimeX();
+#    else
+    return timer_read32();
+#    endif
+}
+
+__attribute__((weak)) uint32_t split_transport_stats_elapsed_us(uint32_t start) {
+#    ifdef PROTOCOL_CHIBIOS
+    return TIME_I2US(chTimeDiffX((systime_t)start, chVTGetSystemTimeX()));
+#    else
+    return timer_elapsed32(start) * 1000;
+#    endif
+}
+
+void split_transport_stats_record(uint8_t index, bool success, uint16_t bytes, uint32_t rtt_us) {
+    if (index >= SPLIT_TRANSPORT_STATS_COUNT) {
+        return;
+    }
+
+    split_transport_stats_t *stats = &transport_stats[index];
+    stats->attempts++;
+    if (last_failed[index]) {
+        stats->retries++;
+    }
+    last_failed[index] = !success;
+
+    if (!success) {
+        stats->failures++;
+        return;
+    }
+
+    stats->bytes += bytes;
+    if (rtt_us != SPLIT_TRANSPORT_STATS_UNTIMED) {
+        uint16_t rtt = rtt_us > UINT16_MAX ? UINT16_MAX : rtt_us;
+        stats->rtt_samples++;
+        stats->rtt_total_us += rtt;
+        if (stats->rtt_samples == 1 || rtt < stats->rtt_min_us) stats->rtt_min_us = rtt;
+        if (rtt > stats->rtt_max_us) stats->rtt_max_us = rtt;
+    }
+}
+
+void split_transport_stats_record_cycle(bool success) {
+    link_stats.cycles++;
+    if (!success) {
+        link_stats.failed_cycles++;
+    }
+}
+
+void split_transport_stats_record_disconnect(void) {
+    link_stats.disconnects++;
+}
+
+void split_transport_stats_print(void) {
+    uprintf("split: %lu cycles, %lu failed, %u disconnects\n", (unsigned long)link_stats.cycles, (unsigned long)link_stats.failed_cycles, link_stats.disconnects);
+    for (uint8_t i = 0; i < SPLIT_TRANSPORT_STATS_COUNT; i++) {
+        const split_transport_stats_t *stats = &transport_stats[i];
+        if (stats->attempts == 0) {
+            continue;
+        }
+        if (i >= NUM_TOTAL_TRANSACTIONS) {
+            uprintf("  frame:");
+        } else {
+            uprintf("  %5u:", i);
+        }
+        uprintf(" %lu tries %lu retries %lu fails %lu bytes", (unsigned long)stats->attempts, (unsigned long)stats->retries, (unsigned long)stats->failures, (unsigned long)stats->bytes);
+        if (stats->rtt_samples) {
+            uprintf(" rtt %u/%u/%u us", stats->rtt_min_us, split_transport_stats_rtt_avg_us(stats), stats->rtt_max_us);
+        }
+        uprintf("\n");
+    }
+}
+
+static uint8_t *stats_put32(uint8_t *dest, uint32_t value) {
+    dest[0] = value & 0xFF;
+    dest[1] = (value >> 8) & 0xFF;
+    dest[2] = (value >> 16) & 0xFF;
+    dest[3] = (value >> 24) & 0xFF;
+    return dest + 4;
+}
+
+static uint8_t *stats_put16(uint8_t *dest, uint16_t value) {
+    dest[0] = value & 0xFF;
+    dest[1] = (value >> 8) & 0xFF;
+    return dest + 2;
+}
+
+bool split_transport_stats_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, index, ... ]
+    if (length < 32 || data[0] != SPLIT_TRANSPORT_STATS_RAW_HID_ID) {
+        return false;
+    }
+
+    uint8_t  index = data[1];
+    uint8_t *reply = &data[3];
+    memset(&data[2], 0, length - 2);
+    data[2] = SPLIT_TRANSPORT_STATS_COUNT;
+
+    if (index == 0xFF) {
+        split_transport_stats_reset();
+    } else if (index == 0xFE) {
+        reply = stats_put32(reply, link_stats.cycles);
+        reply = stats_put32(reply, link_stats.failed_cycles);
+        reply = stats_put16(reply, link_stats.disconnects);
+    } else if (index < SPLIT_TRANSPORT_STATS_COUNT) {
+        const split_transport_stats_t *stats = &transport_stats[index];
+        reply                                = stats_put32(reply, stats->attempts);
+        reply                                = stats_put32(reply, stats->retries);
+        reply                                = stats_put32(reply, stats->failures);
+        reply                                = stats_put32(reply, stats->bytes);
+        reply                                = stats_put16(reply, stats->rtt_min_us);
+        reply                                = stats_put16(reply, split_transport_stats_rtt_avg_us(stats));
+        reply                                = stats_put16(reply, stats->rtt_max_us);
+    } else {
+        data[0] = 0xFF; // unhandled
+    }
+
+#    if defined(RAW_ENABLE)
+    raw_hid_send(data, length);
+#    endif
+    return true;
+}
+
+#endif // SPLIT_TRANSPORT_STATS_ENABLE
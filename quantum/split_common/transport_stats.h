@@ -0,0 +1,72 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "transaction_id_define.h"
+
+#ifndef SPLIT_TRANSPORT_STATS_RAW_HID_ID
+#    define SPLIT_TRANSPORT_STATS_RAW_HID_ID 0xA5
+#endif // SPLIT_TRANSPORT_STATS_RAW_HID_ID
+
+// Frames of coalesced transactions get a counter slot of their own
+#ifdef SPLIT_TRANSPORT_FRAMED
+#    define SPLIT_TRANSPORT_STATS_FRAME NUM_TOTAL_TRANSACTIONS
+#    define SPLIT_TRANSPORT_STATS_COUNT (NUM_TOTAL_TRANSACTIONS + 1)
+#else
+#    define SPLIT_TRANSPORT_STATS_COUNT NUM_TOTAL_TRANSACTIONS
+#endif // SPLIT_TRANSPORT_FRAMED
+
+// Passed as round trip time for exchanges that weren't timed on their own
+#define SPLIT_TRANSPORT_STATS_UNTIMED UINT32_MAX
+
+typedef struct split_transport_stats_t {
+    uint32_t attempts;     // exchanges started
+    uint32_t retries;      // attempts directly following a failed one
+    uint32_t failures;     // attempts that did not complete
+    uint32_t bytes;        // payload bytes moved by successful attempts
+    uint32_t rtt_samples;  // successful attempts that were timed
+    uint32_t rtt_total_us; // sum of their round trip times
+    uint16_t rtt_min_us;
+    uint16_t rtt_max_us;
+} split_transport_stats_t;
+
+typedef struct split_transport_link_stats_t {
+    uint32_t cycles;        // calls to transport_master()
+    uint32_t failed_cycles; // of which returned false
+    uint16_t disconnects;   // times SPLIT_MAX_CONNECTION_ERRORS was reached
+} split_transport_link_stats_t;
+
+/**
+ * @brief Counters for a single transaction ID, or for frames at
+ * SPLIT_TRANSPORT_STATS_FRAME. Returns NULL for an out of range index.
+ */
+const split_transport_stats_t *split_transport_stats_get(uint8_t index);
+
+const split_transport_link_stats_t *split_transport_stats_link(void);
+
+uint16_t split_transport_stats_rtt_avg_us(const split_transport_stats_t *stats);
+
+void split_transport_stats_reset(void);
+
+/**
+ * @brief Dumps all non-zero counters to the console.
+ */
+void split_transport_stats_print(void);
+
+/**
+ * @brief Answers a raw HID stats query, see the split keyboard docs for the
+ * report layout. Returns true, after sending the reply, when the report was
+ * a stats query; false leaves the report untouched.
+ */
+bool split_transport_stats_raw_hid_receive(uint8_t *data, uint8_t length);
+
+// Recording hooks used by the split transport
+uint32_t split_transport_stats_timer(void);
+uint32_t split_transport_stats_elapsed_us(uint32_t start);
+void     split_transport_stats_record(uint8_t index, bool success, uint16_t bytes, uint32_t rtt_us);
+void     split_transport_stats_record_cycle(bool success);
+void     split_transport_stats_record_disconnect(void);
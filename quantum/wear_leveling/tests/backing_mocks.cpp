@@ -17,12 +17,15 @@ void MockBackingStore::reset_instance() {
     backing_erasure_count     = 0;
     backing_max_write_count   = 0;
     backing_total_write_count = 0;
+    backing_sector_erase_count.fill(0);
 
     backing_init_invoke_count   = 0;
     backing_unlock_invoke_count = 0;
-    backing_erase_invoke_count  = 0;
-    backing_write_invoke_count  = 0;
-    backing_lock_invoke_count   = 0;
+    backing_erase_invoke_count        = 0;
+    backing_erase_sector_invoke_count = 0;
+    backing_write_invoke_count        = 0;
+    backing_lock_invoke_count         = 0;
+    backing_read_invoke_count         = 0;
 
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
@@ -31,6 +34,8 @@ void MockBackingStore::reset_instance() {
     lock_success_callback   = [](std::uint64_t) { return true; };
 
     write_log.clear();
+    erase_busy_polls     = 0;
+    erase_busy_remaining = 0;
 }
 
 bool MockBackingStore::init(void) {
@@ -72,9 +77,38 @@ bool MockBackingStore::erase(void) {
     append_log(true);
 
     ++backing_erasure_count;
+    for (auto&& count : backing_sector_erase_count)
+        ++count;
     return true;
 }
 
+bool MockBackingStore::erase_sector(uint32_t address, uint32_t& length) {
+    ++backing_erase_sector_invoke_count;
+
+    EXPECT_TRUE(address % MOCK_SECTOR_SIZE::value == 0) << "Supplied address was not aligned with the sector size";
+    EXPECT_TRUE(address + MOCK_SECTOR_SIZE::value <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+    EXPECT_FALSE(is_locked()) << "Erase was attempted without being unlocked first";
+    EXPECT_EQ(erase_busy_remaining, 0) << "Erase was attempted while a sector was being erased";
+
+    // Erase each slot in the sector
+    for (std::size_t i = 0; i < MOCK_SECTOR_SIZE::value / BACKING_STORE_WRITE_SIZE; ++i) {
+        backing_storage[address / BACKING_STORE_WRITE_SIZE + i].erase();
+    }
+
+    ++backing_sector_erase_count[address / MOCK_SECTOR_SIZE::value];
+    length               = MOCK_SECTOR_SIZE::value;
+    erase_busy_remaining = erase_busy_polls;
+    return true;
+}
+
+bool MockBackingStore::erase_busy(void) {
+    if (erase_busy_remaining > 0) {
+        --erase_busy_remaining;
+        return true;
+    }
+    return false;
+}
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -82,6 +116,7 @@ bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
     EXPECT_TRUE(address + BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
     EXPECT_FALSE(is_locked()) << "Write was attempted without being unlocked first";
+    EXPECT_EQ(erase_busy_remaining, 0) << "Write was attempted while a sector was being erased";
 
     // Drop out of write early with failure if we need to
     if (write_success_callback && !write_success_callback(backing_write_invoke_count, address)) {
@@ -105,6 +140,7 @@ bool MockBackingStore::lock(void) {
     ++backing_lock_invoke_count;
 
     EXPECT_FALSE(is_locked()) << "Attempted to lock but was not unlocked";
+    EXPECT_EQ(erase_busy_remaining, 0) << "Attempted to lock while a sector was being erased";
     locked = true;
 
     if (lock_success_callback) {
@@ -114,6 +150,8 @@ bool MockBackingStore::lock(void) {
 }
 
 bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const {
+    ++backing_read_invoke_count;
+
     // precondition: value's buffer size already matches BACKING_STORE_WRITE_SIZE
     EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
     EXPECT_TRUE(address + BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
@@ -141,6 +179,14 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+extern "C" bool backing_store_erase_sector(uint32_t address, uint32_t* length) {
+    return MockBackingStore::Instance().erase_sector(address, *length);
+}
+
+extern "C" bool backing_store_erase_busy(void) {
+    return MockBackingStore::Instance().erase_busy();
+}
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
@@ -19,6 +19,13 @@ extern "C" {
 using MOCK_WRITE_LOG_MAX_ENTRIES = std::integral_constant<std::size_t, 1024>;
 // Complement to the backing store integral, for emulating flash erases of all bytes=0xFF
 using BACKING_STORE_INTEGRAL_COMPLEMENT = std::integral_constant<backing_store_int_t, ((backing_store_int_t)(~(backing_store_int_t)0))>;
+// Size of each sector erased by backing_store_erase_sector()
+#ifndef WEAR_LEVELING_MOCK_SECTOR_SIZE
+#    define WEAR_LEVELING_MOCK_SECTOR_SIZE 32
+#endif // WEAR_LEVELING_MOCK_SECTOR_SIZE
+using MOCK_SECTOR_SIZE = std::integral_constant<std::size_t, WEAR_LEVELING_MOCK_SECTOR_SIZE>;
+// Total number of sectors in the backing store, including a partial one at the end
+using MOCK_SECTOR_COUNT = std::integral_constant<std::size_t, ((WEAR_LEVELING_BACKING_SIZE + MOCK_SECTOR_SIZE::value - 1) / MOCK_SECTOR_SIZE::value)>;
 // Total number of elements stored in the backing arrays
 using BACKING_STORE_ELEMENT_COUNT = std::integral_constant<std::size_t, (WEAR_LEVELING_BACKING_SIZE / sizeof(backing_store_int_t))>;
 
@@ -87,15 +94,22 @@ class MockBackingStore {
     std::uint64_t backing_max_write_count;
     // The total number of writes to all elements of the backing store
     std::uint64_t backing_total_write_count;
+    // The number of times each sector was erased, either on its own or as part of the whole backing store
+    std::array<std::uint64_t, MOCK_SECTOR_COUNT::value> backing_sector_erase_count;
     // The write log for the backing store
     std::vector<MockBackingStoreLogEntry> write_log;
+    // How many times each sector erase is reported as still running, and how many of those are left
+    std::uint32_t erase_busy_polls;
+    std::uint32_t erase_busy_remaining;
 
     // The number of times each API was invoked
     std::uint64_t backing_init_invoke_count;
     std::uint64_t backing_unlock_invoke_count;
     std::uint64_t backing_erase_invoke_count;
+    std::uint64_t backing_erase_sector_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
+    mutable std::uint64_t backing_read_invoke_count;
 
     // Whether init should succeed
     std::function<bool(std::uint64_t)> init_success_callback;
@@ -130,6 +144,9 @@ class MockBackingStore {
     std::uint64_t total_write_count() const {
         return backing_total_write_count;
     }
+    std::uint64_t sector_erase_count(std::size_t sector) const {
+        return backing_sector_erase_count[sector];
+    }
 
     // The number of times each API was invoked
     std::uint64_t init_invoke_count() const {
@@ -141,12 +158,18 @@ class MockBackingStore {
     std::uint64_t erase_invoke_count() const {
         return backing_erase_invoke_count;
     }
+    std::uint64_t erase_sector_invoke_count() const {
+        return backing_erase_sector_invoke_count;
+    }
     std::uint64_t write_invoke_count() const {
         return backing_write_invoke_count;
     }
     std::uint64_t lock_invoke_count() const {
         return backing_lock_invoke_count;
     }
+    std::uint64_t read_invoke_count() const {
+        return backing_read_invoke_count;
+    }
 
     // Clear out the internal data for the next run
     void reset_instance();
@@ -159,6 +182,8 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_sector(std::uint32_t address, std::uint32_t& length);
+    bool erase_busy();
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
@@ -179,6 +204,9 @@ class MockBackingStore {
     void set_lock_callback(std::function<bool(std::uint64_t)> callback) {
         lock_success_callback = callback;
     }
+    void set_erase_busy_polls(std::uint32_t polls) {
+        erase_busy_polls = polls;
+    }
 
     auto storage_begin() const -> decltype(backing_storage.begin()) {
         return backing_storage.begin();
@@ -63,4 +63,187 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+wear_leveling_transactions_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=128 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_TRANSACTION_RANGES=4
+wear_leveling_transactions_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_transactions.cpp
+wear_leveling_transactions_2byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_transactions_4byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=4 \
+	-DWEAR_LEVELING_BACKING_SIZE=128 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_TRANSACTION_RANGES=4
+wear_leveling_transactions_4byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_transactions.cpp
+wear_leveling_transactions_4byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_transactions_8byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=128 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_TRANSACTION_RANGES=4
+wear_leveling_transactions_8byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_transactions.cpp
+wear_leveling_transactions_8byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_incremental_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_INCREMENTAL_CONSOLIDATION \
+	-DWEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE=16 \
+	-DWEAR_LEVELING_CONSOLIDATION_HEADROOM=32
+wear_leveling_incremental_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_incremental.cpp
+wear_leveling_incremental_2byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_incremental_4byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=4 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_INCREMENTAL_CONSOLIDATION \
+	-DWEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE=16 \
+	-DWEAR_LEVELING_CONSOLIDATION_HEADROOM=32
+wear_leveling_incremental_4byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_incremental.cpp
+wear_leveling_incremental_4byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_incremental_8byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_INCREMENTAL_CONSOLIDATION \
+	-DWEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE=16 \
+	-DWEAR_LEVELING_CONSOLIDATION_HEADROOM=32
+wear_leveling_incremental_8byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_incremental.cpp
+wear_leveling_incremental_8byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_checkpoints_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=1024 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_CHECKPOINTS \
+	-DWEAR_LEVELING_CHECKPOINT_INTERVAL=64
+wear_leveling_checkpoints_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_checkpoints.cpp
+wear_leveling_checkpoints_2byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_checkpoints_4byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=4 \
+	-DWEAR_LEVELING_BACKING_SIZE=1024 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_CHECKPOINTS \
+	-DWEAR_LEVELING_CHECKPOINT_INTERVAL=64
+wear_leveling_checkpoints_4byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_checkpoints.cpp
+wear_leveling_checkpoints_4byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_checkpoints_8byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=1024 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_CHECKPOINTS \
+	-DWEAR_LEVELING_CHECKPOINT_INTERVAL=64
+wear_leveling_checkpoints_8byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_checkpoints.cpp
+wear_leveling_checkpoints_8byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_bench_legacy_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=2048 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024 \
+	-DWEAR_LEVELING_MOCK_SECTOR_SIZE=2048
+wear_leveling_bench_legacy_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_bench.cpp
+wear_leveling_bench_legacy_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_bench_efl_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=8192 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024 \
+	-DWEAR_LEVELING_MOCK_SECTOR_SIZE=2048
+wear_leveling_bench_efl_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_bench.cpp
+wear_leveling_bench_efl_2byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_bench_efl_2byte_incremental_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=8192 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024 \
+	-DWEAR_LEVELING_MOCK_SECTOR_SIZE=2048 \
+	-DWEAR_LEVELING_INCREMENTAL_CONSOLIDATION \
+	-DWEAR_LEVELING_CHECKPOINTS
+wear_leveling_bench_efl_2byte_incremental_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_bench.cpp
+wear_leveling_bench_efl_2byte_incremental_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_bench_rp2040_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=8192 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=4096 \
+	-DWEAR_LEVELING_MOCK_SECTOR_SIZE=4096 \
+	-DWEAR_LEVELING_BENCH_PROGRAM_US=400.0 \
+	-DWEAR_LEVELING_BENCH_ERASE_US=45000.0
+wear_leveling_bench_rp2040_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_bench.cpp
+wear_leveling_bench_rp2040_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_bench_flash_spi_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=16384 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=8192 \
+	-DWEAR_LEVELING_MOCK_SECTOR_SIZE=4096 \
+	-DWEAR_LEVELING_BENCH_PROGRAM_US=100.0 \
+	-DWEAR_LEVELING_BENCH_ERASE_US=45000.0 \
+	-DWEAR_LEVELING_BENCH_READ_US=2.0
+wear_leveling_bench_flash_spi_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_bench.cpp
+wear_leveling_bench_flash_spi_INC := \
+	$(wear_leveling_common_INC)
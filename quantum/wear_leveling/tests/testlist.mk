@@ -3,4 +3,18 @@ TEST_LIST += \
 	wear_leveling_2byte_optimized_writes \
 	wear_leveling_2byte \
 	wear_leveling_4byte \
-	wear_leveling_8byte
+	wear_leveling_8byte \
+	wear_leveling_transactions_2byte \
+	wear_leveling_transactions_4byte \
+	wear_leveling_transactions_8byte \
+	wear_leveling_incremental_2byte \
+	wear_leveling_incremental_4byte \
+	wear_leveling_incremental_8byte \
+	wear_leveling_checkpoints_2byte \
+	wear_leveling_checkpoints_4byte \
+	wear_leveling_checkpoints_8byte \
+	wear_leveling_bench_legacy \
+	wear_leveling_bench_efl_2byte \
+	wear_leveling_bench_efl_2byte_incremental \
+	wear_leveling_bench_rp2040 \
+	wear_leveling_bench_flash_spi
@@ -56,7 +56,7 @@ TEST_F(WearLeveling2ByteOptimizedWrites, MultibyteBackingStoreWriteCounts) {
 /**
  * This test runs through writing U16 values of `0` or `1` over the entire logical address range, to even addresses only.
  *  - Addresses <16384 will result in a single optimised backing write
- *  - Higher addresses will result in a multibyte write of 3 backing writes
+ *  - Higher addresses only log the low byte, as the high byte doesn't change, resulting in a multibyte write of 2 backing writes
  */
 TEST_F(WearLeveling2ByteOptimizedWrites, WriteOneThenZeroToEvenAddresses) {
     auto& inst = MockBackingStore::Instance();
@@ -89,8 +89,8 @@ TEST_F(WearLeveling2ByteOptimizedWrites, WriteOneThenZeroToEvenAddresses) {
                 // A U16 value of 0/1 at an even address <16384 will result in 1 backing write each, so we need 2 backing writes for 2 logical writes
                 backing_store_writes_expected = 2;
             } else {
-                // All other addresses result in a multibyte write (3 backing store writes) to write two local bytes of data
-                backing_store_writes_expected = 6;
+                // All other addresses result in a multibyte write (2 backing store writes) of the only byte which changes
+                backing_store_writes_expected = 4;
             }
 
             // Keep track of the total number of expected writes to the backing store
@@ -114,7 +114,7 @@ TEST_F(WearLeveling2ByteOptimizedWrites, WriteOneThenZeroToEvenAddresses) {
                 // Multibyte write
                 e.raw16[0] = write_iter->value;
                 EXPECT_EQ(LOG_ENTRY_GET_TYPE(e), LOG_ENTRY_TYPE_MULTIBYTE) << "Invalid write log entry type at " << (address + offset);
-                EXPECT_EQ(LOG_ENTRY_MULTIBYTE_GET_LENGTH(e), 2) << "Invalid write log entry length at " << (address + offset);
+                EXPECT_EQ(LOG_ENTRY_MULTIBYTE_GET_LENGTH(e), 1) << "Invalid write log entry length at " << (address + offset);
                 ++write_iter;
             }
 
@@ -143,9 +143,9 @@ TEST_F(WearLeveling2ByteOptimizedWrites, WriteOneThenZeroToEvenAddresses) {
 
 /**
  * This test runs through writing U16 values of `0` or `1` over the entire logical address range, to odd addresses only.
- *  - Addresses <63 will result in 2 optimised backing writes
- *  - Address 63 results in a single optimised backing write for the first logical byte, and a multibyte write of 2 backing writes for the second logical byte
- *  - Higher addresses will result in a multibyte write of 3 backing writes
+ * Only the low byte changes, so only that byte is logged:
+ *  - Addresses <64 will result in a single optimised backing write
+ *  - Higher addresses will result in a multibyte write of 2 backing writes
  */
 TEST_F(WearLeveling2ByteOptimizedWrites, WriteOneThenZeroToOddAddresses) {
     auto& inst = MockBackingStore::Instance();
@@ -174,17 +174,12 @@ TEST_F(WearLeveling2ByteOptimizedWrites, WriteOneThenZeroToOddAddresses) {
             EXPECT_EQ(test_write(address + offset, &val, sizeof(val)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
 
             std::size_t backing_store_writes_expected = 0;
-            if (address + offset < 63) {
-                // A U16 value of 0/1 at an odd address <64 will result in 2 backing writes each, so we need 4 backing writes for 2 logical writes
-                backing_store_writes_expected = 4;
-            } else if (address + offset == 63) {
-                // If we're straddling the boundary for optimised bytes (addr==64), then the first logical byte is written using the optimised write (1 backing
-                // store write), and the second logical byte uses a multibyte write (2 backing store writes)
-                backing_store_writes_expected = 2    // First logical bytes written using optimised log entries
-                                                + 4; // Second logical bytes written using multibyte log entries
+            if (address + offset < 64) {
+                // The low byte at an odd address <64 will result in 1 backing write each, so we need 2 backing writes for 2 logical writes
+                backing_store_writes_expected = 2;
             } else {
-                // All other addresses result in a multibyte write (3 backing store writes) to write two local bytes of data
-                backing_store_writes_expected = 6;
+                // All other addresses result in a multibyte write (2 backing store writes) of the low byte
+                backing_store_writes_expected = 4;
             }
 
             // Keep track of the total number of expected writes to the backing store
@@ -197,29 +192,18 @@ TEST_F(WearLeveling2ByteOptimizedWrites, WriteOneThenZeroToOddAddresses) {
             std::size_t       write_index = expected - backing_store_writes_expected;
             auto              write_iter  = inst.log_begin() + write_index;
             write_log_entry_t e;
-            if (address + offset < 63) {
-                // A U16 value of 0/1 at an odd address <64 will result in 2 backing writes each, so we need 4 backing writes for 2 logical writes
-                for (std::size_t i = 0; i < 4; ++i) {
+            if (address + offset < 64) {
+                // The low byte at an odd address <64 will result in 1 backing write each, so we need 2 backing writes for 2 logical writes
+                for (std::size_t i = 0; i < 2; ++i) {
                     e.raw16[0] = write_iter->value;
                     EXPECT_EQ(LOG_ENTRY_GET_TYPE(e), LOG_ENTRY_TYPE_OPTIMIZED_64) << "Invalid write log entry type";
                     ++write_iter;
                 }
-            } else if (address + offset == 63) {
-                // First log entry is the 64-addr optimised one
-                e.raw16[0] = write_iter->value;
-                EXPECT_EQ(LOG_ENTRY_GET_TYPE(e), LOG_ENTRY_TYPE_OPTIMIZED_64) << "Invalid write log entry type";
-                ++write_iter;
-
-                // Second log entry is the multibyte entry for the second logical byte
-                e.raw16[0] = write_iter->value;
-                EXPECT_EQ(LOG_ENTRY_GET_TYPE(e), LOG_ENTRY_TYPE_MULTIBYTE) << "Invalid write log entry type";
-                EXPECT_EQ(LOG_ENTRY_MULTIBYTE_GET_LENGTH(e), 1) << "Invalid write log entry length";
-                ++write_iter;
             } else {
                 // Multibyte write
                 e.raw16[0] = write_iter->value;
                 EXPECT_EQ(LOG_ENTRY_GET_TYPE(e), LOG_ENTRY_TYPE_MULTIBYTE) << "Invalid write log entry type";
-                EXPECT_EQ(LOG_ENTRY_MULTIBYTE_GET_LENGTH(e), 2) << "Invalid write log entry length";
+                EXPECT_EQ(LOG_ENTRY_MULTIBYTE_GET_LENGTH(e), 1) << "Invalid write log entry length";
                 ++write_iter;
             }
 
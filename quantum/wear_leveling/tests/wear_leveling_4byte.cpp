@@ -191,3 +191,27 @@ TEST_F(WearLeveling4Byte, PlaybackReadbackMultibyte_OOB) {
     EXPECT_EQ(buf[0], 0x11) << "Readback should have maintained the previous pre-failure value from the write log";
     EXPECT_EQ(buf[1], 0x12) << "Readback should have maintained the previous pre-failure value from the write log";
 }
+
+/**
+ * This test verifies that rewriting a block only logs the bytes which changed, as separate entries when that's cheaper.
+ */
+TEST_F(WearLeveling4Byte, PartialRewrite_OnlyChangesLogged) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Generate a test block of data, and write it out
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+    EXPECT_NE(test_write(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_FAILED) << "Write failed with incorrect status";
+
+    // Change two bytes far apart, and rewrite the whole block
+    testvalue[0x02] = 0x55;
+    testvalue[0x0D] = 0x66;
+    uint64_t write_count = inst.write_invoke_count();
+    EXPECT_EQ(test_write(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), write_count + 2) << "Only the two changed bytes should have been logged";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read back the saved data";
+    EXPECT_TRUE(memcmp(readback.data(), verify_data.data(), WEAR_LEVELING_LOGICAL_SIZE) == 0) << "Readback did not match";
+}
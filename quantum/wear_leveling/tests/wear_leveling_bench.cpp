@@ -0,0 +1,261 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Number of operations issued per workload
+#ifndef WEAR_LEVELING_BENCH_OPERATIONS
+#    define WEAR_LEVELING_BENCH_OPERATIONS 2000
+#endif
+
+// Housekeeping task invocations between operations
+#ifndef WEAR_LEVELING_BENCH_TASKS_PER_OPERATION
+#    define WEAR_LEVELING_BENCH_TASKS_PER_OPERATION 4
+#endif
+
+// Rough timings of the backing store, used to model the latency of each call
+#ifndef WEAR_LEVELING_BENCH_PROGRAM_US
+#    define WEAR_LEVELING_BENCH_PROGRAM_US 40.0 // per write unit
+#endif
+#ifndef WEAR_LEVELING_BENCH_ERASE_US
+#    define WEAR_LEVELING_BENCH_ERASE_US 20000.0 // per sector
+#endif
+#ifndef WEAR_LEVELING_BENCH_READ_US
+#    define WEAR_LEVELING_BENCH_READ_US 0.05 // per write unit
+#endif
+
+// Erase cycles each sector is rated for
+#ifndef WEAR_LEVELING_BENCH_ENDURANCE
+#    define WEAR_LEVELING_BENCH_ENDURANCE 10000
+#endif
+
+// Logical layout loosely following eeconfig, VIA's dynamic keymap and its macro buffer
+#define BENCH_RGB_ADDR 8
+#define BENCH_RGB_SIZE 8
+#define BENCH_OS_ADDR 24
+#define BENCH_KEYMAP_ADDR 32
+#define BENCH_KEYMAP_SIZE (std::min<uint32_t>(768, ((WEAR_LEVELING_LOGICAL_SIZE)-BENCH_KEYMAP_ADDR) / 2) & ~1u)
+#define BENCH_MACRO_ADDR (BENCH_KEYMAP_ADDR + BENCH_KEYMAP_SIZE)
+#define BENCH_MACRO_SIZE ((WEAR_LEVELING_LOGICAL_SIZE)-BENCH_MACRO_ADDR)
+
+// VIA transfers at most this many bytes per buffer write
+#define BENCH_VIA_CHUNK 28
+
+struct bench_snapshot_t {
+    uint64_t writes;
+    uint64_t reads;
+    uint64_t erases;
+    uint64_t sector_erases;
+};
+
+struct bench_result_t {
+    uint64_t calls;
+    uint64_t bytes_requested; // passed to wear_leveling_write()
+    uint64_t bytes_changed;   // differing from the logical contents beforehand
+    uint64_t consolidations;
+    double   max_write_us;
+    double   max_task_us;
+    double   max_init_us;
+};
+
+class WearLevelingBench : public ::testing::Test {
+   protected:
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected = {};
+    bench_result_t                                       result   = {};
+    uint32_t                                             seed     = 0x2545F491;
+
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    uint32_t next_random() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    static bench_snapshot_t snapshot() {
+        auto& inst = MockBackingStore::Instance();
+        return {inst.write_invoke_count(), inst.read_invoke_count(), inst.erase_invoke_count(), inst.erase_sector_invoke_count()};
+    }
+
+    // Models the time spent in the backing store since the supplied snapshot
+    static double elapsed_us(const bench_snapshot_t& since) {
+        bench_snapshot_t now = snapshot();
+        return (now.writes - since.writes) * (WEAR_LEVELING_BENCH_PROGRAM_US) + (now.reads - since.reads) * (WEAR_LEVELING_BENCH_READ_US) + ((now.erases - since.erases) * MOCK_SECTOR_COUNT::value + (now.sector_erases - since.sector_erases)) * (WEAR_LEVELING_BENCH_ERASE_US);
+    }
+
+    void count(wear_leveling_status_t status) {
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Wear-leveling returned incorrect status";
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            ++result.consolidations;
+        }
+    }
+
+    void write(uint32_t address, const uint8_t* value, uint32_t length) {
+        for (uint32_t i = 0; i < length; ++i) {
+            result.bytes_changed += expected[address + i] != value[i];
+        }
+        std::copy(value, value + length, &expected[address]);
+
+        bench_snapshot_t before = snapshot();
+        count(wear_leveling_write(address, value, length));
+        result.max_write_us = std::max(result.max_write_us, elapsed_us(before));
+        result.bytes_requested += length;
+        ++result.calls;
+    }
+
+    void write_chunked(uint32_t address, const uint8_t* value, uint32_t length) {
+        for (uint32_t offset = 0; offset < length; offset += BENCH_VIA_CHUNK) {
+            write(address + offset, value + offset, std::min<uint32_t>(BENCH_VIA_CHUNK, length - offset));
+        }
+    }
+
+    void idle() {
+        for (int i = 0; i < WEAR_LEVELING_BENCH_TASKS_PER_OPERATION; ++i) {
+            bench_snapshot_t before = snapshot();
+            count(wear_leveling_task());
+            result.max_task_us = std::max(result.max_task_us, elapsed_us(before));
+        }
+    }
+
+    void reboot() {
+        bench_snapshot_t before = snapshot();
+        count(wear_leveling_init());
+        result.max_init_us = std::max(result.max_init_us, elapsed_us(before));
+    }
+
+    // Periodic RGB mode/hue saves, rewriting the whole config each time
+    void rgb_save() {
+        uint8_t config[BENCH_RGB_SIZE];
+        std::copy(&expected[BENCH_RGB_ADDR], &expected[BENCH_RGB_ADDR + BENCH_RGB_SIZE], config);
+        config[1] += 8;
+        if (next_random() % 8 == 0) {
+            config[0] = next_random() % 40;
+        }
+        write(BENCH_RGB_ADDR, config, BENCH_RGB_SIZE);
+    }
+
+    // VIA keycode changes, with the occasional upload of a whole layout
+    void via_keymap() {
+        if (next_random() % 32 == 0) {
+            uint8_t keymap[BENCH_KEYMAP_SIZE];
+            for (auto& b : keymap) {
+                b = next_random();
+            }
+            write_chunked(BENCH_KEYMAP_ADDR, keymap, BENCH_KEYMAP_SIZE);
+        } else {
+            uint16_t keycode = next_random();
+            write(BENCH_KEYMAP_ADDR + (next_random() % (BENCH_KEYMAP_SIZE / 2)) * 2, (const uint8_t*)&keycode, 2);
+        }
+    }
+
+    // Recording a new macro, followed by its terminator
+    void macro_record() {
+        uint8_t  macro[BENCH_MACRO_SIZE];
+        uint32_t length = std::min<uint32_t>(16 + next_random() % 112, BENCH_MACRO_SIZE - 1);
+        for (uint32_t i = 0; i < length; ++i) {
+            macro[i] = 'a' + next_random() % 26;
+        }
+        macro[length] = 0;
+        write_chunked(BENCH_MACRO_ADDR, macro, length + 1);
+    }
+
+    // OS detection storing its guess on every boot, mostly unchanged
+    void os_detection_boot() {
+        reboot();
+        uint8_t os = next_random() % 8 == 0 ? 1 + next_random() % 4 : expected[BENCH_OS_ADDR] ? expected[BENCH_OS_ADDR] : 1;
+        write(BENCH_OS_ADDR, &os, 1);
+    }
+
+    void report(const char* name, uint32_t operations) {
+        auto&    inst       = MockBackingStore::Instance();
+        uint64_t programmed = inst.total_write_count() * BACKING_STORE_WRITE_SIZE;
+        uint64_t min_erases = UINT64_MAX, max_erases = 0, total_erases = 0;
+        for (std::size_t i = 0; i < MOCK_SECTOR_COUNT::value; ++i) {
+            min_erases = std::min(min_erases, inst.sector_erase_count(i));
+            max_erases = std::max(max_erases, inst.sector_erase_count(i));
+            total_erases += inst.sector_erase_count(i);
+        }
+
+        printf("%-12s %5u ops %6llu calls %8llu bytes written %7llu changed %8llu programmed, amplification %5.1fx (%5.1fx of changed)\n", name, operations, (unsigned long long)result.calls, (unsigned long long)result.bytes_requested, (unsigned long long)result.bytes_changed, (unsigned long long)programmed, result.bytes_requested ? (double)programmed / result.bytes_requested : 0.0, result.bytes_changed ? (double)programmed / result.bytes_changed : 0.0);
+        if (result.consolidations == 0) {
+            printf("    no consolidations\n");
+        } else {
+            printf("    %llu consolidations (%llu full erases), one per %.0f calls\n", (unsigned long long)result.consolidations, (unsigned long long)inst.erase_invoke_count(), (double)result.calls / result.consolidations);
+        }
+        if (max_erases == 0) {
+            printf("    no sector erases\n");
+        } else {
+            printf("    sector erases min %llu avg %.1f max %llu, rated life ~%.0f ops\n", (unsigned long long)min_erases, (double)total_erases / MOCK_SECTOR_COUNT::value, (unsigned long long)max_erases, (double)operations * (WEAR_LEVELING_BENCH_ENDURANCE) / max_erases);
+        }
+        printf("    worst case write %.0f us, task %.0f us, init %.0f us\n", result.max_write_us, result.max_task_us, result.max_init_us);
+    }
+
+    void verify() {
+        reboot();
+        for (uint32_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+            uint8_t value = 0;
+            EXPECT_EQ(wear_leveling_read(i, &value, 1), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+            EXPECT_EQ(value, expected[i]) << "Invalid readback at " << i;
+        }
+    }
+
+    template <typename F>
+    void run(const char* name, F&& operation) {
+        for (uint32_t i = 0; i < WEAR_LEVELING_BENCH_OPERATIONS; ++i) {
+            operation();
+            idle();
+        }
+        report(name, WEAR_LEVELING_BENCH_OPERATIONS);
+        verify();
+    }
+
+    static void SetUpTestSuite() {
+        printf("write size %u, backing size %u, logical size %u, sector size %u", BACKING_STORE_WRITE_SIZE, WEAR_LEVELING_BACKING_SIZE, WEAR_LEVELING_LOGICAL_SIZE, (unsigned)MOCK_SECTOR_SIZE::value);
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+        printf(", incremental consolidation");
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#ifdef WEAR_LEVELING_CHECKPOINTS
+        printf(", checkpoints");
+#endif // WEAR_LEVELING_CHECKPOINTS
+        printf("\n");
+    }
+};
+
+TEST_F(WearLevelingBench, RgbSaves) {
+    run("rgb", [this] { rgb_save(); });
+}
+
+TEST_F(WearLevelingBench, ViaKeymap) {
+    run("via keymap", [this] { via_keymap(); });
+}
+
+TEST_F(WearLevelingBench, MacroRecording) {
+    run("macro", [this] { macro_record(); });
+}
+
+TEST_F(WearLevelingBench, OsDetection) {
+    run("os detection", [this] { os_detection_boot(); });
+}
+
+TEST_F(WearLevelingBench, Mixed) {
+    run("mixed", [this] {
+        uint32_t pick = next_random() % 16;
+        if (pick < 10) {
+            rgb_save();
+        } else if (pick < 13) {
+            via_keymap();
+        } else if (pick < 14) {
+            macro_record();
+        } else {
+            os_detection_boot();
+        }
+    });
+}
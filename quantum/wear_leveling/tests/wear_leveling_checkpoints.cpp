@@ -0,0 +1,115 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <algorithm>
+#include <array>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingCheckpoints : public ::testing::Test {
+   protected:
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected = {};
+
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    wear_leveling_status_t write(uint32_t address, uint8_t value) {
+        expected[address]             = value;
+        wear_leveling_status_t status = wear_leveling_write(address, &value, 1);
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+        return status;
+    }
+
+    // The checkpoint table entry at the supplied index
+    static auto table_entry(std::size_t index) -> decltype(MockBackingStore::Instance().storage_begin()) {
+        return MockBackingStore::Instance().storage_begin() + ((WEAR_LEVELING_LOGICAL_SIZE + 8) / sizeof(backing_store_int_t)) + index;
+    }
+
+    // Writes a handful of distinct values until the first checkpoint is published
+    void write_until_checkpoint() {
+        for (uint32_t i = 0; table_entry(0)->is_erased(); ++i) {
+            ASSERT_LT(i, 1000u) << "Checkpoint was never written";
+            ASSERT_EQ(write(i % 8, (uint8_t)(i + 1)), WEAR_LEVELING_SUCCESS) << "Write log filled up before a checkpoint";
+        }
+    }
+
+    uint64_t init_reads() {
+        auto&    inst  = MockBackingStore::Instance();
+        uint64_t reads = inst.read_invoke_count();
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        return inst.read_invoke_count() - reads;
+    }
+
+    void verify() {
+        for (uint32_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+            uint8_t value = 0;
+            EXPECT_EQ(wear_leveling_read(i, &value, 1), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+            EXPECT_EQ(value, expected[i]) << "Invalid readback at " << i;
+        }
+    }
+};
+
+/**
+ * This test verifies that the number of reads during init doesn't grow with the amount of the write log in use.
+ */
+TEST_F(WearLevelingCheckpoints, BootReads_Flat) {
+    const uint64_t empty_reads = init_reads();
+    uint64_t       max_reads   = 0;
+
+    uint32_t i = 0;
+    for (; write((i * 5) % 16, (uint8_t)(i + 1)) == WEAR_LEVELING_SUCCESS; ++i) {
+        if (i % 16 == 15) {
+            max_reads = std::max(max_reads, init_reads());
+            verify();
+        }
+    }
+
+    // Consolidated data, the table search, the latest checkpoint and what came after it
+    EXPECT_GT(i, 32u) << "Write log filled up too early";
+    EXPECT_LT(max_reads, empty_reads + 2 * (WEAR_LEVELING_CHECKPOINT_INTERVAL + 64) / BACKING_STORE_WRITE_SIZE) << "Init reads grew with the write log";
+    EXPECT_LT(max_reads, (WEAR_LEVELING_BACKING_SIZE / 2) / BACKING_STORE_WRITE_SIZE) << "Init reads not bounded by checkpoints";
+
+    // Consolidation starts over with an empty table
+    EXPECT_TRUE(table_entry(0)->is_erased()) << "Checkpoint table wasn't cleared on consolidation";
+    init_reads();
+    verify();
+}
+
+/**
+ * This test verifies that a damaged checkpoint falls back to playing back the whole write log.
+ */
+TEST_F(WearLevelingCheckpoints, CorruptCheckpoint_FullPlayback) {
+    write_until_checkpoint();
+
+    // Corrupt the first entry after the checkpoint's begin entry
+    auto it = MockBackingStore::Instance().storage_begin() + (backing_store_int_t)~table_entry(0)->get() + (LOG_ENTRY_EXTENDED_SIZE / sizeof(backing_store_int_t));
+    auto v  = it->get();
+    it->erase();
+    it->set(v ^ 0x0100);
+
+    init_reads();
+    verify();
+
+    // Carrying on writes the next checkpoint to the next table entry
+    for (uint32_t i = 0; table_entry(1)->is_erased(); ++i) {
+        ASSERT_LT(i, 1000u) << "Checkpoint was never written";
+        ASSERT_EQ(write(0x20 + i % 8, (uint8_t)(i + 1)), WEAR_LEVELING_SUCCESS) << "Write log filled up before a checkpoint";
+    }
+    init_reads();
+    verify();
+}
+
+/**
+ * This test verifies that a checkpoint which was never published is ignored.
+ */
+TEST_F(WearLevelingCheckpoints, UnpublishedCheckpoint_Ignored) {
+    write_until_checkpoint();
+
+    // Lose power just before the checkpoint is published
+    table_entry(0)->erase();
+
+    init_reads();
+    verify();
+}
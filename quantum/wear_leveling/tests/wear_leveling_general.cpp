@@ -109,7 +109,7 @@ TEST_F(WearLevelingGeneral, WriteFailure_OOB) {
 TEST_F(WearLevelingGeneral, WriteSuccess_BoundaryOK) {
     auto& inst = MockBackingStore::Instance();
 
-    uint16_t test_val = 0x14;
+    uint16_t test_val = 0x1414;
     EXPECT_EQ(wear_leveling_write(WEAR_LEVELING_LOGICAL_SIZE - sizeof(test_val), &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Overall write operation should have succeeded";
 
     EXPECT_EQ(inst.unlock_invoke_count(), 1) << "Unlock should have been invoked once";
@@ -0,0 +1,193 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <array>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingIncremental : public ::testing::Test {
+   protected:
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected = {};
+
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    void write(uint32_t address, uint8_t value) {
+        expected[address] = value;
+        EXPECT_EQ(wear_leveling_write(address, &value, 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    // Enough single-byte writes to get into the headroom without filling the log
+    void start_consolidation() {
+        for (uint32_t i = 0; i < 32 / BACKING_STORE_WRITE_SIZE; ++i) {
+            write(i, 0x80 | i);
+        }
+    }
+
+    // Runs the task until a consolidation completes
+    static bool settle() {
+        for (int i = 0; i < 64; ++i) {
+            wear_leveling_status_t status = wear_leveling_task();
+            EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Task returned incorrect status";
+            if (status == WEAR_LEVELING_CONSOLIDATED) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void verify() {
+        for (uint32_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+            uint8_t value = 0;
+            EXPECT_EQ(wear_leveling_read(i, &value, 1), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+            EXPECT_EQ(value, expected[i]) << "Invalid readback at " << i;
+        }
+    }
+};
+
+/**
+ * This test verifies that consolidation happens from the task without ever erasing the whole backing store or
+ * consolidating in-line.
+ */
+TEST_F(WearLevelingIncremental, Background_NoInlineConsolidation) {
+    auto& inst           = MockBackingStore::Instance();
+    int   consolidations = 0;
+    for (uint32_t i = 0; i < 500; ++i) {
+        write((i * 7) % WEAR_LEVELING_LOGICAL_SIZE, (uint8_t)(i + 1));
+        for (int j = 0; j < 3; ++j) {
+            wear_leveling_status_t status = wear_leveling_task();
+            EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Task returned incorrect status";
+            if (status == WEAR_LEVELING_CONSOLIDATED) {
+                ++consolidations;
+            }
+        }
+    }
+
+    EXPECT_GT(consolidations, 10) << "Consolidation didn't happen in the background";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Backing store was erased in full";
+    verify();
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify();
+}
+
+/**
+ * This test verifies that a sector erase which is still running is checked on from later task calls rather than waited
+ * for, and that writes in the meantime wait for it.
+ */
+TEST_F(WearLevelingIncremental, SlowErase_PolledFromTask) {
+    auto& inst = MockBackingStore::Instance();
+    inst.set_erase_busy_polls(3);
+    start_consolidation();
+
+    // The first call only starts erasing the first sector, the next ones find it still running
+    uint64_t erase_count = inst.erase_sector_invoke_count();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    EXPECT_EQ(inst.erase_sector_invoke_count(), erase_count + 1) << "Task didn't start an erase";
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+        EXPECT_FALSE(inst.is_locked()) << "Backing store was locked during an erase";
+    }
+    EXPECT_EQ(inst.erase_sector_invoke_count(), erase_count + 1) << "Task started an erase while another was running";
+
+    // A write has to wait for the erase in progress
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    write(0x30, 0x5A);
+    EXPECT_TRUE(inst.is_locked()) << "Backing store wasn't locked after the write";
+
+    EXPECT_TRUE(settle()) << "Consolidation didn't complete";
+    verify();
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify();
+}
+
+/**
+ * This test verifies that losing power at any point during a consolidation keeps all written data.
+ */
+TEST_F(WearLevelingIncremental, PowerLoss_AtEveryStep) {
+    for (int steps = 0; steps < 16; ++steps) {
+        MockBackingStore::Instance().reset_instance();
+        expected.fill(0);
+        wear_leveling_init();
+        start_consolidation();
+
+        for (int i = 0; i < steps; ++i) {
+            wear_leveling_task();
+        }
+
+        EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init returned incorrect status";
+        verify();
+    }
+}
+
+/**
+ * This test verifies that writes made while the cache is being copied end up in the new bank.
+ */
+TEST_F(WearLevelingIncremental, WritesDuringCopy_Carried) {
+    start_consolidation();
+
+    // Erase the inactive bank, and copy the first chunk
+    for (uint32_t i = 0; i < (WEAR_LEVELING_BACKING_SIZE / 2) / MOCK_SECTOR_SIZE::value + 1; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+    write(1, 0x11);
+    write(WEAR_LEVELING_LOGICAL_SIZE - 1, 0x22);
+    EXPECT_TRUE(settle()) << "Consolidation didn't complete";
+    verify();
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify();
+}
+
+/**
+ * This test verifies that a full write log without any task calls finishes the consolidation in-line, bank by bank.
+ */
+TEST_F(WearLevelingIncremental, FullLog_FinishesInline) {
+    auto&                  inst   = MockBackingStore::Instance();
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (uint32_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE && status == WEAR_LEVELING_SUCCESS; ++i) {
+        uint8_t value = (uint8_t)(i + 1);
+        expected[i]   = value;
+        status        = wear_leveling_write(i, &value, 1);
+    }
+
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Write log never filled up";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Backing store was erased in full";
+    EXPECT_EQ(inst.erase_sector_invoke_count(), (WEAR_LEVELING_BACKING_SIZE / 2) / MOCK_SECTOR_SIZE::value) << "Only the inactive bank should be erased";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify();
+}
+
+/**
+ * This test verifies that an open transaction holds off the switch-over until it's committed.
+ */
+TEST_F(WearLevelingIncremental, Transaction_HoldsOffSwitch) {
+    start_consolidation();
+
+    EXPECT_EQ(wear_leveling_transaction_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    write(0x20, 0x33);
+    write(0x30, 0x44);
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Consolidated during a transaction";
+    }
+
+    // Nothing from the transaction may be visible after a power loss
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    expected[0x20] = 0;
+    expected[0x30] = 0;
+    verify();
+
+    start_consolidation();
+    EXPECT_EQ(wear_leveling_transaction_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    write(0x20, 0x33);
+    write(0x30, 0x44);
+    EXPECT_NE(wear_leveling_transaction_commit(), WEAR_LEVELING_FAILED) << "Commit returned incorrect status";
+    settle();
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify();
+}
@@ -0,0 +1,188 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingTransactions : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    // The first unused element of the write log
+    static auto log_end() -> decltype(MockBackingStore::Instance().storage_begin()) {
+        auto& inst = MockBackingStore::Instance();
+        auto  it   = inst.storage_begin() + ((WEAR_LEVELING_LOGICAL_SIZE + 8) / sizeof(backing_store_int_t));
+        while (it != inst.storage_end() && !it->is_erased()) {
+            ++it;
+        }
+        return it;
+    }
+
+    static uint8_t read_byte(uint32_t address) {
+        uint8_t value = 0;
+        EXPECT_EQ(wear_leveling_read(address, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        return value;
+    }
+};
+
+/**
+ * This test verifies that writes inside a transaction stay in the cache until commit, and are played back afterwards.
+ */
+TEST_F(WearLevelingTransactions, Commit_WritesOnCommitOnly) {
+    auto&   inst      = MockBackingStore::Instance();
+    uint8_t values[4] = {0x11, 0x22, 0x33, 0x44};
+
+    EXPECT_EQ(wear_leveling_transaction_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    uint64_t write_count = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_write(0x01, &values[0], 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_write(0x10, values, 4), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_write(0x12, &values[3], 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_write(0x20, &values[1], 2), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), write_count) << "Backing store written before commit";
+    EXPECT_EQ(read_byte(0x12), 0x44) << "Cache not updated before commit";
+
+    EXPECT_EQ(wear_leveling_transaction_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+    EXPECT_GT(inst.write_invoke_count(), write_count) << "Backing store not written on commit";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_byte(0x01), 0x11) << "Invalid readback";
+    EXPECT_EQ(read_byte(0x10), 0x11) << "Invalid readback";
+    EXPECT_EQ(read_byte(0x11), 0x22) << "Invalid readback";
+    EXPECT_EQ(read_byte(0x12), 0x44) << "Invalid readback";
+    EXPECT_EQ(read_byte(0x13), 0x44) << "Invalid readback";
+    EXPECT_EQ(read_byte(0x20), 0x22) << "Invalid readback";
+    EXPECT_EQ(read_byte(0x21), 0x33) << "Invalid readback";
+}
+
+/**
+ * This test verifies that only the outermost commit of nested transactions writes to the backing store.
+ */
+TEST_F(WearLevelingTransactions, Nested_OutermostCommitWrites) {
+    auto&   inst  = MockBackingStore::Instance();
+    uint8_t value = 0x5A;
+
+    EXPECT_EQ(wear_leveling_transaction_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    EXPECT_EQ(wear_leveling_transaction_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    uint64_t write_count = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_write(0x08, &value, 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_transaction_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), write_count) << "Inner commit wrote to the backing store";
+    EXPECT_EQ(wear_leveling_transaction_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+    EXPECT_GT(inst.write_invoke_count(), write_count) << "Outer commit didn't write to the backing store";
+
+    EXPECT_EQ(wear_leveling_transaction_commit(), WEAR_LEVELING_FAILED) << "Unbalanced commit should fail";
+}
+
+/**
+ * This test verifies that a transaction whose commit entry never made it to the backing store is dropped in full.
+ */
+TEST_F(WearLevelingTransactions, InterruptedCommit_Dropped) {
+    uint8_t before = 0x42;
+    EXPECT_EQ(wear_leveling_write(0x30, &before, 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    uint8_t values[6] = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(wear_leveling_transaction_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    EXPECT_EQ(wear_leveling_write(0x00, values, 6), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_write(0x20, values, 3), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_transaction_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+
+    // Lose power just before the commit entry is written
+    auto end = log_end();
+    for (std::size_t i = 0; i < LOG_ENTRY_EXTENDED_SIZE / sizeof(backing_store_int_t); ++i) {
+        (--end)->erase();
+    }
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Init should have consolidated the truncated log";
+    EXPECT_EQ(read_byte(0x30), 0x42) << "Write before the transaction was lost";
+    for (uint32_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(read_byte(0x00 + i), 0) << "Uncommitted write was played back";
+    }
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(read_byte(0x20 + i), 0) << "Uncommitted write was played back";
+    }
+}
+
+/**
+ * This test verifies that a damaged transaction is dropped rather than partially applied.
+ */
+TEST_F(WearLevelingTransactions, CorruptTransaction_Dropped) {
+    uint8_t values[7] = {9, 8, 7, 6, 5, 4, 3};
+    EXPECT_EQ(wear_leveling_transaction_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    EXPECT_EQ(wear_leveling_write(0x10, values, 7), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_transaction_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+
+    // Corrupt the last data element before the commit entry
+    auto it = log_end() - (LOG_ENTRY_EXTENDED_SIZE / sizeof(backing_store_int_t)) - 1;
+    auto v  = it->get();
+    it->erase();
+    it->set(v ^ 0x0100);
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Init should have consolidated the damaged log";
+    for (uint32_t i = 0; i < 7; ++i) {
+        EXPECT_EQ(read_byte(0x10 + i), 0) << "Damaged transaction was played back";
+    }
+}
+
+/**
+ * This test verifies that a transaction changing a single log entry's worth of data is logged like a plain write.
+ */
+TEST_F(WearLevelingTransactions, SingleEntry_NotFramed) {
+    uint8_t plain = 0x12;
+    auto    start = log_end();
+    EXPECT_EQ(wear_leveling_write(0x20, &plain, 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    auto plain_length = log_end() - start;
+
+    uint8_t value = 0x34;
+    start         = log_end();
+    EXPECT_EQ(wear_leveling_transaction_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    EXPECT_EQ(wear_leveling_write(0x21, &value, 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(wear_leveling_transaction_commit(), WEAR_LEVELING_SUCCESS) << "Commit returned incorrect status";
+    EXPECT_EQ(log_end() - start, plain_length) << "Single entry transaction was framed";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_byte(0x20), 0x12) << "Invalid readback";
+    EXPECT_EQ(read_byte(0x21), 0x34) << "Invalid readback";
+}
+
+/**
+ * This test verifies that a transaction too large for the rest of the write log becomes a single consolidation.
+ */
+TEST_F(WearLevelingTransactions, TooLargeForLog_Consolidates) {
+    auto& inst = MockBackingStore::Instance();
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+
+    uint64_t erase_count = inst.erase_invoke_count();
+    EXPECT_EQ(wear_leveling_transaction_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    for (std::size_t i = 0; i < testvalue.size(); i += 8) {
+        EXPECT_EQ(wear_leveling_write(i, &testvalue[i], 8), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_transaction_commit(), WEAR_LEVELING_CONSOLIDATED) << "Commit should have consolidated";
+    EXPECT_EQ(inst.erase_invoke_count(), erase_count + 1) << "Commit should have erased exactly once";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    for (std::size_t i = 0; i < testvalue.size(); ++i) {
+        EXPECT_EQ(read_byte(i), testvalue[i]) << "Invalid readback";
+    }
+}
+
+/**
+ * This test verifies that a transaction touching more ranges than can be tracked consolidates on commit.
+ */
+TEST_F(WearLevelingTransactions, TooManyRanges_Consolidates) {
+    EXPECT_EQ(wear_leveling_transaction_begin(), WEAR_LEVELING_SUCCESS) << "Begin returned incorrect status";
+    for (uint8_t i = 0; i <= WEAR_LEVELING_TRANSACTION_RANGES; ++i) {
+        uint8_t value = 0x80 | i;
+        EXPECT_EQ(wear_leveling_write(i * 2, &value, 1), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_transaction_commit(), WEAR_LEVELING_CONSOLIDATED) << "Commit should have consolidated";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    for (uint8_t i = 0; i <= WEAR_LEVELING_TRANSACTION_RANGES; ++i) {
+        EXPECT_EQ(read_byte(i * 2), 0x80 | i) << "Invalid readback";
+    }
+}
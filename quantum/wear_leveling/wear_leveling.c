@@ -5,6 +5,41 @@
 #include "wear_leveling.h"
 #include "wear_leveling_internal.h"
 
+#ifndef WEAR_LEVELING_TRANSACTION_RANGES
+#    define WEAR_LEVELING_TRANSACTION_RANGES 8
+#endif // WEAR_LEVELING_TRANSACTION_RANGES
+
+#ifndef WEAR_LEVELING_WRITE_RUNS
+#    define WEAR_LEVELING_WRITE_RUNS 4
+#endif // WEAR_LEVELING_WRITE_RUNS
+_Static_assert((WEAR_LEVELING_WRITE_RUNS) > 0, "At least one run per write is required");
+
+#ifndef WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE
+#    define WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE 64
+#endif // WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE
+_Static_assert((WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE) % (BACKING_STORE_WRITE_SIZE) == 0, "Consolidation chunk size must be a multiple of write size");
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#    ifndef WEAR_LEVELING_CONSOLIDATION_HEADROOM
+#        define WEAR_LEVELING_CONSOLIDATION_HEADROOM (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOGICAL_SIZE) - 8) / 4)
+#    endif // WEAR_LEVELING_CONSOLIDATION_HEADROOM
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+#ifdef WEAR_LEVELING_CHECKPOINTS
+#    ifndef WEAR_LEVELING_CHECKPOINT_INTERVAL
+#        define WEAR_LEVELING_CHECKPOINT_INTERVAL 256
+#    endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+#    define WEAR_LEVELING_CHECKPOINT_SLOTS (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOGICAL_SIZE) - 8) / (WEAR_LEVELING_CHECKPOINT_INTERVAL))
+#    define WEAR_LEVELING_CHECKPOINT_TABLE_SIZE ((WEAR_LEVELING_CHECKPOINT_SLOTS) * (BACKING_STORE_WRITE_SIZE))
+_Static_assert((WEAR_LEVELING_CHECKPOINT_SLOTS) > 0, "Checkpoint interval must be smaller than the write log");
+_Static_assert((WEAR_LEVELING_CHECKPOINT_INTERVAL) % (BACKING_STORE_WRITE_SIZE) == 0, "Checkpoint interval must be a multiple of write size");
+#    if BACKING_STORE_WRITE_SIZE == 2
+_Static_assert((WEAR_LEVELING_BANK_SIZE) / 2 < UINT16_MAX, "Checkpoint table entries can't address the whole write log");
+#    endif
+#else
+#    define WEAR_LEVELING_CHECKPOINT_TABLE_SIZE 0
+#endif // WEAR_LEVELING_CHECKPOINTS
+
 /*
     This wear leveling algorithm is adapted from algorithms from previous
     implementations in QMK, namely:
@@ -153,7 +188,86 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Extended log entries:
+
+        Further entry types use the last type discriminator, with a 6-bit
+        subtype and a 24-bit argument. They take 4 bytes, or a single write for
+        8-byte backing stores.
+
+        ╔ Extended Log Entry ═══════════════╗
+        ║11SSSSSS║AAAAAAAA║AAAAAAAA║AAAAAAAA║
+        ║  └─┬──┘║└──┬───┘║└──┬───┘║└──┬───┘║
+        ║ Subtype║Argument║Argument║Argument║
+        ╚════════╩════════╩════════╩════════╝
+
+    Transactions:
+
+        Writes made between wear_leveling_transaction_begin() and
+        wear_leveling_transaction_commit() only update the cache. On commit, the
+        changed ranges are logged as normal entries, enclosed by a begin entry
+        holding their length in bytes and a commit entry holding their folded
+        FNV1a_32. During playback a transaction is only applied if its commit
+        entry is present and matches, so an interrupted commit leaves none of
+        its writes behind. A transaction that changed a single range which
+        fits into one log entry is logged like a plain write, without the
+        begin and commit entries. A transaction that doesn't fit into what's
+        left of the write log is written as a single consolidation instead.
+
+    Incremental consolidation:
+
+        With WEAR_LEVELING_INCREMENTAL_CONSOLIDATION defined, the backing store
+        is split into two equally-sized banks, each laid out as described above.
+        Only one bank is active at a time. Once the active bank's write log has
+        less than WEAR_LEVELING_CONSOLIDATION_HEADROOM bytes left, the inactive
+        bank is prepared from wear_leveling_task(), one step per call:
+            * The inactive bank is erased, a sector at a time. Drivers that
+                can return while the erase is running are polled through
+                backing_store_erase_busy() on later calls, and anything else
+                that needs the backing store waits for it.
+            * The cache is copied into its consolidated data area, a chunk at a
+                time. Writes made in the meantime keep going to the active bank.
+            * Its write log is started with a bank sequence entry, one greater
+                than the active bank's, followed by log entries for anything
+                that changed after its chunk was copied.
+            * Lastly, the FNV1a_64 of the copied data is written, at which point
+                the inactive bank becomes the active one.
+        On init, the bank with a valid checksum and the newest sequence number
+        is used, so a power loss at any point leaves the previous bank in use.
+        If the active bank's write log fills up before the inactive bank is
+        ready, the remaining steps are performed in-line.
+
+    Checkpoints:
+
+        With WEAR_LEVELING_CHECKPOINTS defined, a table of
+        WEAR_LEVELING_CHECKPOINT_SLOTS write-sized entries sits between the
+        FNV1a_64 of the consolidated data and the write log. Whenever at least
+        WEAR_LEVELING_CHECKPOINT_INTERVAL bytes have been logged since the last
+        checkpoint, a new one is appended to the write log:
+            * A checkpoint begin entry, holding the length of what follows.
+            * Log entries for every byte of the cache that differs from the
+                consolidated data.
+            * A checkpoint commit entry, holding the folded FNV1a_32 of the
+                whole cache.
+        The checkpoint is then published by writing its position (in write
+        units from the start of the bank) to the next free table entry. On
+        init, the consolidated data is read, the latest published checkpoint
+        is applied on top, and the result checked against its hash.
+        Playback then only needs to continue from the end of the checkpoint.
+        If anything doesn't match, the whole log is played back instead --
+        checkpoint contents are skipped there, as they are redundant. A
+        checkpoint is only written once more has been logged since the last
+        one than the checkpoint itself takes, so boot time is bounded by the
+        logical size and the interval rather than by the size of the log. */
+
+/**
+ * A range of logical addresses.
+ */
+typedef struct {
+    uint32_t address;
+    uint32_t length;
+} wear_leveling_range_t;
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,17 +276,80 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+    struct {
+        uint8_t  depth;
+        uint8_t  range_count;
+        bool     overflowed; // more ranges than fit, commit consolidates instead
+        bool     measuring;  // appends only count their length
+        uint32_t length;
+        uint32_t entries;    // log entries written or measured since it was last cleared
+        uint32_t hash;
+        wear_leveling_range_t ranges[(WEAR_LEVELING_TRANSACTION_RANGES)];
+    } transaction;
+#ifdef WEAR_LEVELING_CHECKPOINTS
+    struct {
+        uint16_t count;    // published checkpoints, and the next free table entry
+        uint32_t last_end; // end of the last checkpoint, or the start of the log
+        uint32_t next;     // write address from which the next checkpoint is considered
+    } checkpoint;
+#endif // WEAR_LEVELING_CHECKPOINTS
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    uint32_t bank_base;
+    uint32_t bank_sequence;
+    struct {
+        uint8_t  state;
+        bool     erasing; // a sector erase is still running, and keeps the backing store unlocked
+        uint32_t address; // progress through the inactive bank
+        uint64_t hash;    // FNV1a_64 of the consolidated data copied so far
+    } consolidation;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#    define WEAR_LEVELING_BANK_BASE (wear_leveling.bank_base)
+#    define WEAR_LEVELING_INACTIVE_BANK_BASE (wear_leveling.bank_base == 0 ? (WEAR_LEVELING_BANK_SIZE) : 0)
+
+/**
+ * Incremental consolidation states, advanced by wear_leveling_task()
+ */
+enum { CONSOLIDATION_IDLE = 0, CONSOLIDATION_ERASING, CONSOLIDATION_COPYING, CONSOLIDATION_FINISHING };
+#else
+#    define WEAR_LEVELING_BANK_BASE 0
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+#define WEAR_LEVELING_CHECKPOINT_TABLE (WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOGICAL_SIZE) + 8) // +8 due to the FNV1a_64 of the consolidated area
+#define WEAR_LEVELING_LOG_START (WEAR_LEVELING_CHECKPOINT_TABLE + (WEAR_LEVELING_CHECKPOINT_TABLE_SIZE))
+#define WEAR_LEVELING_LOG_END (WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_BANK_SIZE))
+
 /**
  * Locking helper: status
  */
 typedef enum backing_store_lock_status_t { STATUS_FAILURE = 0, STATUS_SUCCESS, STATUS_UNCHANGED } backing_store_lock_status_t;
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Waits for a sector erase started by a consolidation step to finish.
+ */
+static void wear_leveling_erase_wait(void) {
+    if (wear_leveling.consolidation.erasing) {
+        while (backing_store_erase_busy()) {
+        }
+        wear_leveling.consolidation.erasing = false;
+    }
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 /**
  * Locking helper: unlock
  */
 static inline backing_store_lock_status_t wear_leveling_unlock(void) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Take over the unlock held by a background erase, once it's done
+    if (wear_leveling.consolidation.erasing) {
+        wear_leveling_erase_wait();
+        return STATUS_SUCCESS;
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
     if (wear_leveling.unlocked) {
         return STATUS_UNCHANGED;
     }
@@ -197,23 +374,46 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
     return STATUS_SUCCESS;
 }
 
+#ifdef WEAR_LEVELING_CHECKPOINTS
 /**
- * Resets the cache, ensuring the write address is correctly initialised.
+ * Resets checkpoint tracking for an empty write log.
+ */
+static void wear_leveling_checkpoint_reset(void) {
+    wear_leveling.checkpoint.count    = 0;
+    wear_leveling.checkpoint.last_end = WEAR_LEVELING_LOG_START;
+    wear_leveling.checkpoint.next     = WEAR_LEVELING_LOG_START + (WEAR_LEVELING_CHECKPOINT_INTERVAL);
+}
+#else
+#    define wear_leveling_checkpoint_reset() \
+        do {                                \
+        } while (0)
+#endif // WEAR_LEVELING_CHECKPOINTS
+
+/**
+ * Resets the cache, ensuring the write address is correctly initialised. Drops any open transaction or background consolidation.
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    memset(&wear_leveling.transaction, 0, sizeof(wear_leveling.transaction));
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    memset(&wear_leveling.consolidation, 0, sizeof(wear_leveling.consolidation));
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START;
+    wear_leveling_checkpoint_reset();
 }
 
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
+ *
+ * @param valid[out] whether the consolidated data matched its checksum
  */
-static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+static wear_leveling_status_t wear_leveling_read_consolidated(bool *valid) {
     wl_dprintf("Reading consolidated data\n");
 
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
-    if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    *valid                        = false;
+    if (!backing_store_read_bulk(WEAR_LEVELING_BANK_BASE, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to read from backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
@@ -224,16 +424,17 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
         write_log_entry_t entry;
         wl_dprintf("Reading checksum\n");
 #if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
+        backing_store_read_bulk(WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
 #elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
+        backing_store_read_bulk(WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
 #elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
+        backing_store_read(WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
 #endif
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
         if (entry.raw64 == expected) {
             wl_dprintf("Checksum matches, consolidated data is correct\n");
+            *valid = true;
         } else {
             wl_dprintf("Checksum mismatch, clearing cache\n");
             wear_leveling_clear_cache();
@@ -248,6 +449,50 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     return status;
 }
 
+/**
+ * Writes the FNV1a_64 of a bank's consolidated data, just after it.
+ */
+static bool wear_leveling_write_checksum(uint32_t address, uint64_t hash) {
+    write_log_entry_t entry;
+    entry.raw64 = hash;
+    wl_dprintf("Writing checksum\n");
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry.raw64);
+#endif
+}
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+static void                   wear_leveling_consolidation_start(void);
+static wear_leveling_status_t wear_leveling_consolidation_step(void);
+
+/**
+ * Forces a write of the current cache.
+ * Completes any background consolidation in-line, switching to the other bank. The active bank stays intact until the
+ * switch, so a power loss doesn't lose data.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    wl_dprintf("Finishing consolidation in-line\n");
+
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE) {
+        wear_leveling_consolidation_start();
+    }
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    wear_leveling_status_t      status      = lock_status == STATUS_FAILURE ? WEAR_LEVELING_FAILED : WEAR_LEVELING_SUCCESS;
+    while (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_consolidation_step();
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        wear_leveling_lock();
+    }
+    return status;
+}
+#else
 /**
  * Writes the current cache to consolidated data at the beginning of the backing store.
  * Does not clear the write log.
@@ -265,27 +510,9 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
 
     if (status != WEAR_LEVELING_FAILED) {
         // Write out the FNV1a_64 result of the consolidated data
-        write_log_entry_t entry;
-        entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        if (!wear_leveling_write_checksum((WEAR_LEVELING_LOGICAL_SIZE), fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT))) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -316,10 +543,12 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START;
+    wear_leveling_checkpoint_reset();
 
     return status;
 }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Potential write of the current cache to the backing store.
@@ -329,10 +558,17 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    if (wear_leveling.write_address >= WEAR_LEVELING_LOG_END) {
         return wear_leveling_consolidate_force();
     }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Start preparing the other bank in the background well before the log is full
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE && wear_leveling.write_address + (WEAR_LEVELING_CONSOLIDATION_HEADROOM) >= WEAR_LEVELING_LOG_END) {
+        wear_leveling_consolidation_start();
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     return WEAR_LEVELING_SUCCESS;
 }
 
@@ -342,6 +578,13 @@ static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value) {
+    // While measuring a transaction, nothing is written
+    if (wear_leveling.transaction.measuring) {
+        wear_leveling.transaction.length += (BACKING_STORE_WRITE_SIZE);
+        return WEAR_LEVELING_SUCCESS;
+    }
+    wear_leveling.transaction.hash = fnv_32a_buf(&value, sizeof(value), wear_leveling.transaction.hash);
+
     bool ok = backing_store_write(wear_leveling.write_address, value);
     if (!ok) {
         wl_dprintf("Failed to write to backing store\n");
@@ -410,6 +653,29 @@ static wear_leveling_status_t wear_leveling_write_raw_multibyte(uint32_t address
     return status;
 }
 
+/**
+ * Handles writing extended entries to the backing store.
+ *
+ * @return true if consolidation occurred
+ */
+static wear_leveling_status_t wear_leveling_write_raw_extended(uint8_t subtype, uint32_t argument) {
+    write_log_entry_t log = LOG_ENTRY_MAKE_EXTENDED(subtype, argument);
+
+    wear_leveling_status_t status;
+#if BACKING_STORE_WRITE_SIZE == 2
+    status = wear_leveling_append_raw(log.raw16[0]);
+    if (status != WEAR_LEVELING_SUCCESS) {
+        return status;
+    }
+    status = wear_leveling_append_raw(log.raw16[1]);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    status = wear_leveling_append_raw(log.raw32[0]);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    status = wear_leveling_append_raw(log.raw64);
+#endif
+    return status;
+}
+
 /**
  * Handles the actual writing of logical data into the write log section of the backing store.
  */
@@ -418,6 +684,7 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     size_t                 remaining = length;
     wear_leveling_status_t status    = WEAR_LEVELING_SUCCESS;
     while (remaining > 0) {
+        ++wear_leveling.transaction.entries;
 #if BACKING_STORE_WRITE_SIZE == 2
         // Small-write optimizations - uint16_t, 0 or 1, address is even, address <16384:
         if (remaining >= 2 && address % 2 == 0 && address < 16384) {
@@ -470,15 +737,236 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
 }
 
 /**
- * "Replays" the write log from the backing store, updating the local cache with updated values.
+ * Reads an extended entry from the write log.
  */
-static wear_leveling_status_t wear_leveling_playback_log(void) {
-    wl_dprintf("Playback write log\n");
+static bool wear_leveling_read_extended(uint32_t address, write_log_entry_t *log) {
+    log->raw64 = 0;
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, log->raw16, 2);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read(address, &log->raw32[0]);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &log->raw64);
+#endif
+}
+
+/**
+ * Folds an FNV1a_32 hash down to the size of an extended entry's argument.
+ */
+static inline uint32_t wear_leveling_fold_hash(Fnv32_t hash) {
+    return ((hash >> 24) ^ hash) & LOG_ENTRY_EXTENDED_MAX_ARGUMENT;
+}
+
+/**
+ * Checks that a transaction in the write log was committed in full.
+ *
+ * @param address[in] the backing store address just after the transaction's begin entry
+ * @param length[in] the length of the transaction's entries, from the begin entry
+ */
+static bool wear_leveling_transaction_committed(uint32_t address, uint32_t length) {
+    const uint32_t end = address + length;
+    if (length % (BACKING_STORE_WRITE_SIZE) != 0 || end + (LOG_ENTRY_EXTENDED_SIZE) > WEAR_LEVELING_LOG_END) {
+        return false;
+    }
+
+    Fnv32_t hash = FNV1_32A_INIT;
+    for (; address < end; address += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        if (!backing_store_read(address, &value)) {
+            return false;
+        }
+        hash = fnv_32a_buf(&value, sizeof(value), hash);
+    }
+
+    write_log_entry_t log;
+    if (!wear_leveling_read_extended(end, &log)) {
+        return false;
+    }
+    return LOG_ENTRY_GET_TYPE(log) == LOG_ENTRY_TYPE_EXTENDED && LOG_ENTRY_EXTENDED_GET_SUBTYPE(log) == LOG_ENTRY_EXTENDED_TRANSACTION_COMMIT && LOG_ENTRY_EXTENDED_GET_ARGUMENT(log) == wear_leveling_fold_hash(hash);
+}
+
+#if defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION) || defined(WEAR_LEVELING_CHECKPOINTS)
+/**
+ * Logs the parts of the cache that differ from the consolidated data in the bank at the supplied base.
+ */
+static wear_leveling_status_t wear_leveling_write_changes(uint32_t base) {
+    backing_store_int_t copied[(WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+    for (uint32_t address = 0; address < (WEAR_LEVELING_LOGICAL_SIZE); address += (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE)) {
+        const uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE) - address < (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE) ? (WEAR_LEVELING_LOGICAL_SIZE) - address : (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE);
+        if (!backing_store_read_bulk(base + address, copied, length / (BACKING_STORE_WRITE_SIZE))) {
+            return WEAR_LEVELING_FAILED;
+        }
+
+        const uint8_t *p = (const uint8_t *)copied;
+        for (uint32_t i = 0; i < length;) {
+            if (p[i] == wear_leveling.cache[address + i]) {
+                ++i;
+                continue;
+            }
+            const uint32_t start = i;
+            while (i < length && p[i] != wear_leveling.cache[address + i]) {
+                ++i;
+            }
+            wear_leveling_status_t status = wear_leveling_write_raw(address + start, &wear_leveling.cache[address + start], i - start);
+            if (status != WEAR_LEVELING_SUCCESS) {
+                return status;
+            }
+        }
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+#endif // defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION) || defined(WEAR_LEVELING_CHECKPOINTS)
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Starts preparing the inactive bank from the current cache.
+ */
+static void wear_leveling_consolidation_start(void) {
+    wl_dprintf("Starting consolidation into the inactive bank\n");
+    wear_leveling.consolidation.state   = CONSOLIDATION_ERASING;
+    wear_leveling.consolidation.address = 0;
+}
+
+/**
+ * Switches over to the freshly-copied inactive bank. Its checksum is written last, so until then the active bank is
+ * still the one used on init.
+ */
+static wear_leveling_status_t wear_leveling_consolidation_finish(void) {
+    const uint32_t base             = WEAR_LEVELING_INACTIVE_BANK_BASE;
+    const uint32_t previous_base    = wear_leveling.bank_base;
+    const uint32_t previous_address = wear_leveling.write_address;
+
+    // Work out the length of the entries for anything changed during the copy without writing them
+    wear_leveling.transaction.measuring = true;
+    wear_leveling.transaction.length    = 0;
+    wear_leveling_status_t status       = wear_leveling_write_changes(base);
+    wear_leveling.transaction.measuring = false;
+    if (status == WEAR_LEVELING_FAILED) {
+        wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+        return status;
+    }
+    if (wear_leveling.transaction.length + (LOG_ENTRY_EXTENDED_SIZE) >= WEAR_LEVELING_LOG_END - WEAR_LEVELING_LOG_START) {
+        wl_dprintf("Too much changed during consolidation, starting over\n");
+        wear_leveling_consolidation_start();
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wear_leveling.bank_base     = base;
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START;
+    status                      = wear_leveling_write_raw_extended(LOG_ENTRY_EXTENDED_BANK_SEQUENCE, (wear_leveling.bank_sequence + 1) & LOG_ENTRY_EXTENDED_MAX_ARGUMENT);
+    if (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_write_changes(base);
+    }
+    if (status == WEAR_LEVELING_SUCCESS && !wear_leveling_write_checksum(base + (WEAR_LEVELING_LOGICAL_SIZE), wear_leveling.consolidation.hash)) {
+        status = WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+    if (status != WEAR_LEVELING_SUCCESS) {
+        // The previous bank hasn't been touched, so carry on using it
+        wl_dprintf("Failed to switch banks\n");
+        wear_leveling.bank_base     = previous_base;
+        wear_leveling.write_address = previous_address;
+        return WEAR_LEVELING_FAILED;
+    }
 
+    wl_dprintf("Switched banks\n");
+    wear_leveling.bank_sequence = (wear_leveling.bank_sequence + 1) & LOG_ENTRY_EXTENDED_MAX_ARGUMENT;
+    wear_leveling_checkpoint_reset();
+    return WEAR_LEVELING_CONSOLIDATED;
+}
+
+/**
+ * Performs the next step of preparing the inactive bank.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the inactive bank has become the active one
+ */
+static wear_leveling_status_t wear_leveling_consolidation_step(void) {
+    const uint32_t base = WEAR_LEVELING_INACTIVE_BANK_BASE;
+
+    // Nothing else can be done with the backing store while a sector is being erased
+    wear_leveling_erase_wait();
+
+    switch (wear_leveling.consolidation.state) {
+        case CONSOLIDATION_ERASING: {
+            uint32_t length = 0;
+            if (!backing_store_erase_sector(base + wear_leveling.consolidation.address, &length) || length == 0) {
+                wl_dprintf("Failed to erase inactive bank\n");
+                wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+                return WEAR_LEVELING_FAILED;
+            }
+            wear_leveling.consolidation.erasing = true;
+            wear_leveling.consolidation.address += length;
+            if (wear_leveling.consolidation.address >= (WEAR_LEVELING_BANK_SIZE)) {
+                wear_leveling.consolidation.state   = CONSOLIDATION_COPYING;
+                wear_leveling.consolidation.address = 0;
+                wear_leveling.consolidation.hash    = FNV1A_64_INIT;
+            }
+        } break;
+        case CONSOLIDATION_COPYING: {
+            const uint32_t address = wear_leveling.consolidation.address;
+            const uint32_t length  = (WEAR_LEVELING_LOGICAL_SIZE) - address < (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE) ? (WEAR_LEVELING_LOGICAL_SIZE) - address : (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE);
+            if (!backing_store_write_bulk(base + address, (backing_store_int_t *)&wear_leveling.cache[address], length / (BACKING_STORE_WRITE_SIZE))) {
+                wl_dprintf("Failed to write inactive bank\n");
+                wear_leveling.consolidation.state = CONSOLIDATION_IDLE;
+                return WEAR_LEVELING_FAILED;
+            }
+            wear_leveling.consolidation.hash = fnv_64a_buf(&wear_leveling.cache[address], length, wear_leveling.consolidation.hash);
+            wear_leveling.consolidation.address += length;
+            if (wear_leveling.consolidation.address >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                wear_leveling.consolidation.state = CONSOLIDATION_FINISHING;
+            }
+        } break;
+        case CONSOLIDATION_FINISHING:
+            return wear_leveling_consolidation_finish();
+        default:
+            break;
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Picks the bank with valid consolidated data and the newest sequence number, and reads it into the cache.
+ */
+static wear_leveling_status_t wear_leveling_select_bank(void) {
+    bool     valid[2]    = {false, false};
+    uint32_t sequence[2] = {0, 0};
+    for (uint8_t bank = 0; bank < 2; ++bank) {
+        wear_leveling.bank_base = bank * (WEAR_LEVELING_BANK_SIZE);
+        if (wear_leveling_read_consolidated(&valid[bank]) == WEAR_LEVELING_FAILED) {
+            valid[bank] = false;
+        }
+
+        // A bank without a sequence entry was never switched to, which only happens for the first bank after an erase
+        write_log_entry_t log;
+        if (valid[bank] && wear_leveling_read_extended(WEAR_LEVELING_LOG_START, &log) && LOG_ENTRY_GET_TYPE(log) == LOG_ENTRY_TYPE_EXTENDED && LOG_ENTRY_EXTENDED_GET_SUBTYPE(log) == LOG_ENTRY_EXTENDED_BANK_SEQUENCE) {
+            sequence[bank] = LOG_ENTRY_EXTENDED_GET_ARGUMENT(log);
+        }
+    }
+
+    // Sequence numbers wrap around, so compare them by their difference
+    uint32_t newer = (sequence[1] - sequence[0]) & LOG_ENTRY_EXTENDED_MAX_ARGUMENT;
+    uint8_t  bank  = (valid[1] && (!valid[0] || (newer != 0 && newer <= (LOG_ENTRY_EXTENDED_MAX_ARGUMENT >> 1)))) ? 1 : 0;
+    wl_dprintf("Using bank %d\n", (int)bank);
+
+    wear_leveling.bank_base     = bank * (WEAR_LEVELING_BANK_SIZE);
+    wear_leveling.bank_sequence = sequence[bank];
+    return wear_leveling_read_consolidated(&valid[bank]);
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+/**
+ * Plays back the write log entries from the backing store between the supplied addresses, updating the local cache.
+ * Stops early at the first empty slot.
+ *
+ * @param start[in,out] the address of the first entry, updated to the address just after the last entry played back
+ * @param end[in] the address to stop at
+ */
+static wear_leveling_status_t wear_leveling_playback_entries(uint32_t *start, uint32_t end) {
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    uint32_t               address         = *start;
+    while (!cancel_playback && address < end) {
         backing_store_int_t value;
         bool                ok = backing_store_read(address, &value);
         if (!ok) {
@@ -590,6 +1078,48 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 wear_leveling.cache[a + 1] = 0;
             } break;
 #endif // BACKING_STORE_WRITE_SIZE == 2
+            case LOG_ENTRY_TYPE_EXTENDED: {
+#if BACKING_STORE_WRITE_SIZE == 2
+                ok = backing_store_read(address, &log.raw16[1]);
+                if (!ok) {
+                    wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
+                    cancel_playback = true;
+                    status          = WEAR_LEVELING_FAILED;
+                    break;
+                }
+                address += (BACKING_STORE_WRITE_SIZE);
+#endif // BACKING_STORE_WRITE_SIZE == 2
+                switch (LOG_ENTRY_EXTENDED_GET_SUBTYPE(log)) {
+                    case LOG_ENTRY_EXTENDED_TRANSACTION_BEGIN:
+                        // An uncommitted transaction is dropped, along with the rest of the log
+                        if (!wear_leveling_transaction_committed(address, LOG_ENTRY_EXTENDED_GET_ARGUMENT(log))) {
+                            wl_dprintf("Incomplete transaction, skipping playback of remaining write log\n");
+                            cancel_playback = true;
+                            status          = WEAR_LEVELING_FAILED;
+                        }
+                        break;
+#ifdef WEAR_LEVELING_CHECKPOINTS
+                    case LOG_ENTRY_EXTENDED_CHECKPOINT_BEGIN: {
+                        // Checkpoint contents only repeat what came before them in the log
+                        const uint32_t length = LOG_ENTRY_EXTENDED_GET_ARGUMENT(log);
+                        if (length % (BACKING_STORE_WRITE_SIZE) != 0 || address + length > end) {
+                            cancel_playback = true;
+                            status          = WEAR_LEVELING_FAILED;
+                            break;
+                        }
+                        address += length;
+                    } break;
+                    case LOG_ENTRY_EXTENDED_CHECKPOINT_COMMIT:
+#endif // WEAR_LEVELING_CHECKPOINTS
+                    case LOG_ENTRY_EXTENDED_TRANSACTION_COMMIT:
+                    case LOG_ENTRY_EXTENDED_BANK_SEQUENCE:
+                        break;
+                    default:
+                        cancel_playback = true;
+                        status          = WEAR_LEVELING_FAILED;
+                        break;
+                }
+            } break;
             default: {
                 cancel_playback = true;
                 status          = WEAR_LEVELING_FAILED;
@@ -597,6 +1127,133 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         }
     }
 
+    *start = address;
+    return status;
+}
+
+#ifdef WEAR_LEVELING_CHECKPOINTS
+/**
+ * Writes a checkpoint of the cache to the write log if enough has been logged since the last one.
+ */
+static wear_leveling_status_t wear_leveling_checkpoint_if_needed(void) {
+    if (wear_leveling.write_address < wear_leveling.checkpoint.next || wear_leveling.checkpoint.count >= (WEAR_LEVELING_CHECKPOINT_SLOTS)) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Work out the length of the entries for everything differing from the consolidated data without writing them
+    wear_leveling.transaction.measuring = true;
+    wear_leveling.transaction.length    = 0;
+    wear_leveling_status_t status       = wear_leveling_write_changes(WEAR_LEVELING_BANK_BASE);
+    wear_leveling.transaction.measuring = false;
+    if (status == WEAR_LEVELING_FAILED) {
+        return status;
+    }
+
+    // Don't spend more on the checkpoint than it saves during playback
+    const uint32_t length = wear_leveling.transaction.length;
+    const uint32_t total  = length + 2 * (LOG_ENTRY_EXTENDED_SIZE);
+    if (wear_leveling.write_address - wear_leveling.checkpoint.last_end < total) {
+        wear_leveling.checkpoint.next = wear_leveling.checkpoint.last_end + total;
+        return WEAR_LEVELING_SUCCESS;
+    }
+    if (wear_leveling.write_address + total >= WEAR_LEVELING_LOG_END) {
+        wear_leveling.checkpoint.next = WEAR_LEVELING_LOG_END;
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Writing checkpoint\n");
+    const uint32_t begin = wear_leveling.write_address;
+    status               = wear_leveling_write_raw_extended(LOG_ENTRY_EXTENDED_CHECKPOINT_BEGIN, length);
+    if (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_write_changes(WEAR_LEVELING_BANK_BASE);
+    }
+    if (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_write_raw_extended(LOG_ENTRY_EXTENDED_CHECKPOINT_COMMIT, wear_leveling_fold_hash(fnv_32a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1_32A_INIT)));
+    }
+    if (status != WEAR_LEVELING_SUCCESS) {
+        return status;
+    }
+
+    // Publish the checkpoint only once it's complete
+    if (!backing_store_write(WEAR_LEVELING_CHECKPOINT_TABLE + wear_leveling.checkpoint.count * (BACKING_STORE_WRITE_SIZE), (backing_store_int_t)((begin - WEAR_LEVELING_BANK_BASE) / (BACKING_STORE_WRITE_SIZE)))) {
+        wl_dprintf("Failed to write to backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+    ++wear_leveling.checkpoint.count;
+    wear_leveling.checkpoint.last_end = wear_leveling.write_address;
+    wear_leveling.checkpoint.next     = wear_leveling.write_address + (WEAR_LEVELING_CHECKPOINT_INTERVAL);
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Applies the latest published checkpoint on top of the consolidated data in the cache.
+ * If it can't be used, the cache is reloaded from the consolidated data.
+ *
+ * @return the address to continue playback of the write log from
+ */
+static uint32_t wear_leveling_checkpoint_restore(void) {
+    // Checkpoints are published in order, so find the last used table entry
+    backing_store_int_t value = 0;
+    uint16_t            count = 0;
+    uint16_t            lo = 0, hi = (WEAR_LEVELING_CHECKPOINT_SLOTS);
+    while (lo < hi) {
+        const uint16_t      mid = lo + (hi - lo) / 2;
+        backing_store_int_t entry;
+        if (!backing_store_read(WEAR_LEVELING_CHECKPOINT_TABLE + mid * (BACKING_STORE_WRITE_SIZE), &entry)) {
+            wl_dprintf("Failed to load from backing store, skipping checkpoints\n");
+            wear_leveling.checkpoint.count = (WEAR_LEVELING_CHECKPOINT_SLOTS);
+            return WEAR_LEVELING_LOG_START;
+        }
+        if (entry == 0) {
+            hi = mid;
+        } else {
+            lo    = mid + 1;
+            count = lo;
+            value = entry;
+        }
+    }
+    wear_leveling.checkpoint.count = count;
+    if (count == 0) {
+        return WEAR_LEVELING_LOG_START;
+    }
+
+    const uint32_t    begin = WEAR_LEVELING_BANK_BASE + (uint32_t)value * (BACKING_STORE_WRITE_SIZE);
+    write_log_entry_t log;
+    if (begin >= WEAR_LEVELING_LOG_START && begin + 2 * (LOG_ENTRY_EXTENDED_SIZE) <= WEAR_LEVELING_LOG_END && wear_leveling_read_extended(begin, &log) && LOG_ENTRY_GET_TYPE(log) == LOG_ENTRY_TYPE_EXTENDED && LOG_ENTRY_EXTENDED_GET_SUBTYPE(log) == LOG_ENTRY_EXTENDED_CHECKPOINT_BEGIN) {
+        const uint32_t length  = LOG_ENTRY_EXTENDED_GET_ARGUMENT(log);
+        uint32_t       address = begin + (LOG_ENTRY_EXTENDED_SIZE);
+        const uint32_t end     = address + length;
+        if (length % (BACKING_STORE_WRITE_SIZE) == 0 && end + (LOG_ENTRY_EXTENDED_SIZE) <= WEAR_LEVELING_LOG_END && wear_leveling_playback_entries(&address, end) == WEAR_LEVELING_SUCCESS && address == end && wear_leveling_read_extended(end, &log) && LOG_ENTRY_GET_TYPE(log) == LOG_ENTRY_TYPE_EXTENDED && LOG_ENTRY_EXTENDED_GET_SUBTYPE(log) == LOG_ENTRY_EXTENDED_CHECKPOINT_COMMIT
+            && LOG_ENTRY_EXTENDED_GET_ARGUMENT(log) == wear_leveling_fold_hash(fnv_32a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1_32A_INIT))) {
+            wl_dprintf("Restored checkpoint\n");
+            wear_leveling.checkpoint.last_end = end + (LOG_ENTRY_EXTENDED_SIZE);
+            wear_leveling.checkpoint.next     = wear_leveling.checkpoint.last_end + (WEAR_LEVELING_CHECKPOINT_INTERVAL);
+            return wear_leveling.checkpoint.last_end;
+        }
+    }
+
+    // The checkpoint may have been partially applied, so start over from the consolidated data
+    wl_dprintf("Invalid checkpoint, playing back the whole write log\n");
+    bool valid;
+    wear_leveling_read_consolidated(&valid);
+    wear_leveling.checkpoint.count = count;
+    return WEAR_LEVELING_LOG_START;
+}
+#endif // WEAR_LEVELING_CHECKPOINTS
+
+/**
+ * "Replays" the write log from the backing store, updating the local cache with updated values.
+ */
+static wear_leveling_status_t wear_leveling_playback_log(void) {
+    wl_dprintf("Playback write log\n");
+
+#ifdef WEAR_LEVELING_CHECKPOINTS
+    uint32_t address = wear_leveling_checkpoint_restore();
+#else
+    uint32_t address = WEAR_LEVELING_LOG_START;
+#endif // WEAR_LEVELING_CHECKPOINTS
+    wear_leveling_status_t status = wear_leveling_playback_entries(&address, WEAR_LEVELING_LOG_END);
+
     // We've reached the end of the log, so we're at the new write location
     wear_leveling.write_address = address;
 
@@ -617,6 +1274,14 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Don't abandon a background erase with the backing store unlocked
+    if (wear_leveling.consolidation.erasing) {
+        wear_leveling_erase_wait();
+        wear_leveling_lock();
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     // Reset the cache
     wear_leveling_clear_cache();
 
@@ -628,7 +1293,12 @@ wear_leveling_status_t wear_leveling_init(void) {
     }
 
     // Read the previous consolidated values, then replay the existing write log so that the cache has the "live" values
-    wear_leveling_status_t status = wear_leveling_read_consolidated();
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    wear_leveling_status_t status = wear_leveling_select_bank();
+#else
+    bool                   valid;
+    wear_leveling_status_t status = wear_leveling_read_consolidated(&valid);
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
     if (status == WEAR_LEVELING_FAILED) {
         // If it failed, clear the cache and return with failure
         wear_leveling_clear_cache();
@@ -661,6 +1331,10 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    wear_leveling.bank_base     = 0;
+    wear_leveling.bank_sequence = 0;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
     wear_leveling_clear_cache();
 
     // Lock the backing store if we acquired the lock successfully
@@ -671,6 +1345,191 @@ wear_leveling_status_t wear_leveling_erase(void) {
     return ret ? WEAR_LEVELING_SUCCESS : WEAR_LEVELING_FAILED;
 }
 
+/**
+ * Works out the length of the write log entries for the supplied data without writing them.
+ */
+static uint32_t wear_leveling_measure_raw(uint32_t address, const uint8_t *value, size_t length) {
+    wear_leveling.transaction.measuring = true;
+    wear_leveling.transaction.length    = 0;
+    wear_leveling_write_raw(address, value, length);
+    wear_leveling.transaction.measuring = false;
+    return wear_leveling.transaction.length;
+}
+
+/**
+ * Finds the parts of a write which differ from the cache. Neighbouring runs of changed bytes are merged whenever logging
+ * the unchanged bytes between them is no more expensive than logging them separately. Once out of runs, the remainder
+ * of the changes is covered by the last one. Falls back to the whole write if the runs don't save anything.
+ * Pre-condition: at least one byte differs, and the cache hasn't been updated yet.
+ *
+ * @return the number of runs
+ */
+static uint8_t wear_leveling_find_runs(uint32_t address, const uint8_t *value, size_t length, wear_leveling_range_t *runs) {
+    uint8_t count = 0;
+    for (uint32_t i = 0; i < length;) {
+        if (value[i] == wear_leveling.cache[address + i]) {
+            ++i;
+            continue;
+        }
+        const uint32_t start = i;
+        while (i < length && value[i] != wear_leveling.cache[address + i]) {
+            ++i;
+        }
+
+        if (count > 0) {
+            wear_leveling_range_t *last     = &runs[count - 1];
+            const uint32_t         offset   = last->address - address;
+            const uint32_t         separate = wear_leveling_measure_raw(last->address, &value[offset], last->length) + wear_leveling_measure_raw(address + start, &value[start], i - start);
+            if (count == (WEAR_LEVELING_WRITE_RUNS) || wear_leveling_measure_raw(last->address, &value[offset], i - offset) <= separate) {
+                last->length = i - offset;
+                continue;
+            }
+        }
+        runs[count].address = address + start;
+        runs[count].length  = i - start;
+        ++count;
+    }
+
+    // Keep the write as-is if that's no more expensive, as with the 2-byte store's word encodings
+    uint32_t runs_length = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        runs_length += wear_leveling_measure_raw(runs[i].address, &value[runs[i].address - address], runs[i].length);
+    }
+    if (wear_leveling_measure_raw(address, value, length) <= runs_length) {
+        runs[0].address = address;
+        runs[0].length  = length;
+        count           = 1;
+    }
+    return count;
+}
+
+/**
+ * Records a range of the cache that the current transaction changed, merging it with any range it overlaps or touches.
+ */
+static void wear_leveling_transaction_add_range(uint32_t address, uint32_t length) {
+    uint32_t end = address + length;
+    for (uint8_t i = 0; i < wear_leveling.transaction.range_count;) {
+        uint32_t range_address = wear_leveling.transaction.ranges[i].address;
+        uint32_t range_end     = range_address + wear_leveling.transaction.ranges[i].length;
+        if (range_address <= end && address <= range_end) {
+            // Absorb the existing range, and check the rest against the combined one
+            address = address < range_address ? address : range_address;
+            end     = end > range_end ? end : range_end;
+            wear_leveling.transaction.ranges[i] = wear_leveling.transaction.ranges[--wear_leveling.transaction.range_count];
+            continue;
+        }
+        ++i;
+    }
+
+    if (wear_leveling.transaction.range_count >= (WEAR_LEVELING_TRANSACTION_RANGES)) {
+        wear_leveling.transaction.overflowed = true;
+        return;
+    }
+    wear_leveling.transaction.ranges[wear_leveling.transaction.range_count].address = address;
+    wear_leveling.transaction.ranges[wear_leveling.transaction.range_count].length  = end - address;
+    ++wear_leveling.transaction.range_count;
+}
+
+/**
+ * Logs the ranges changed by the current transaction.
+ */
+static wear_leveling_status_t wear_leveling_transaction_write_ranges(void) {
+    for (uint8_t i = 0; i < wear_leveling.transaction.range_count; ++i) {
+        uint32_t               address = wear_leveling.transaction.ranges[i].address;
+        wear_leveling_status_t status  = wear_leveling_write_raw(address, &wear_leveling.cache[address], wear_leveling.transaction.ranges[i].length);
+        if (status != WEAR_LEVELING_SUCCESS) {
+            return status;
+        }
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Writes the current transaction to the write log as a single unit, or consolidates if it doesn't fit.
+ */
+static wear_leveling_status_t wear_leveling_transaction_write(void) {
+    if (!wear_leveling.transaction.overflowed) {
+        // Work out the length of the transaction's entries without writing them
+        wear_leveling.transaction.measuring = true;
+        wear_leveling.transaction.length    = 0;
+        wear_leveling.transaction.entries   = 0;
+        wear_leveling_transaction_write_ranges();
+        wear_leveling.transaction.measuring = false;
+
+        // A lone entry is no less atomic than a plain write, so it needs no framing
+        if (wear_leveling.transaction.range_count == 1 && wear_leveling.transaction.entries == 1) {
+            return wear_leveling_transaction_write_ranges();
+        }
+
+        uint32_t length = wear_leveling.transaction.length;
+        if (length <= LOG_ENTRY_EXTENDED_MAX_ARGUMENT && wear_leveling.write_address + length + 2 * (LOG_ENTRY_EXTENDED_SIZE) <= WEAR_LEVELING_LOG_END) {
+            wear_leveling_status_t status = wear_leveling_write_raw_extended(LOG_ENTRY_EXTENDED_TRANSACTION_BEGIN, length);
+            if (status != WEAR_LEVELING_SUCCESS) {
+                return status;
+            }
+
+            // Everything fits, so only the commit entry can fill the log up
+            wear_leveling.transaction.hash = FNV1_32A_INIT;
+            status                         = wear_leveling_transaction_write_ranges();
+            if (status != WEAR_LEVELING_SUCCESS) {
+                return status;
+            }
+            return wear_leveling_write_raw_extended(LOG_ENTRY_EXTENDED_TRANSACTION_COMMIT, wear_leveling_fold_hash(wear_leveling.transaction.hash));
+        }
+    }
+
+    wl_dprintf("Transaction doesn't fit into the write log, consolidating\n");
+    return wear_leveling_consolidate_force();
+}
+
+/**
+ * Starts a wear-leveling transaction.
+ */
+wear_leveling_status_t wear_leveling_transaction_begin(void) {
+    if (wear_leveling.transaction.depth == UINT8_MAX) {
+        return WEAR_LEVELING_FAILED;
+    }
+    ++wear_leveling.transaction.depth;
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Commits a wear-leveling transaction to the backing store.
+ */
+wear_leveling_status_t wear_leveling_transaction_commit(void) {
+    if (wear_leveling.transaction.depth == 0) {
+        return WEAR_LEVELING_FAILED;
+    }
+    if (--wear_leveling.transaction.depth > 0 || (wear_leveling.transaction.range_count == 0 && !wear_leveling.transaction.overflowed)) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Unlock the backing store
+    wear_leveling_status_t      status      = WEAR_LEVELING_FAILED;
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+    } else {
+        status = wear_leveling_transaction_write();
+        if (status == WEAR_LEVELING_SUCCESS) {
+            // Consolidate the cache + write log if required
+            status = wear_leveling_consolidate_if_needed();
+        }
+#ifdef WEAR_LEVELING_CHECKPOINTS
+        if (status == WEAR_LEVELING_SUCCESS) {
+            status = wear_leveling_checkpoint_if_needed();
+        }
+#endif // WEAR_LEVELING_CHECKPOINTS
+        if (lock_status == STATUS_SUCCESS && wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    wear_leveling.transaction.range_count = 0;
+    wear_leveling.transaction.overflowed  = false;
+    return status;
+}
+
 /**
  * Writes logical data into the backing store. Skips writes if there are no changes to values.
  */
@@ -688,9 +1547,20 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         return true;
     }
 
+    // Only log the bytes which actually change
+    wear_leveling_range_t runs[(WEAR_LEVELING_WRITE_RUNS)];
+    const uint8_t         run_count = wear_leveling_find_runs(address, value, length, runs);
+
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
+    // Inside a transaction, the write log is only written on commit
+    if (wear_leveling.transaction.depth > 0) {
+        const uint32_t end = runs[run_count - 1].address + runs[run_count - 1].length;
+        wear_leveling_transaction_add_range(runs[0].address, end - runs[0].address);
+        return WEAR_LEVELING_SUCCESS;
+    }
+
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -699,7 +1569,10 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     }
 
     // Perform the actual write
-    wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (uint8_t i = 0; i < run_count && status == WEAR_LEVELING_SUCCESS; ++i) {
+        status = wear_leveling_write_raw(runs[i].address, &wear_leveling.cache[runs[i].address], runs[i].length);
+    }
     switch (status) {
         case WEAR_LEVELING_CONSOLIDATED:
         case WEAR_LEVELING_FAILED:
@@ -709,6 +1582,11 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         case WEAR_LEVELING_SUCCESS:
             // Consolidate the cache + write log if required
             status = wear_leveling_consolidate_if_needed();
+#ifdef WEAR_LEVELING_CHECKPOINTS
+            if (status == WEAR_LEVELING_SUCCESS) {
+                status = wear_leveling_checkpoint_if_needed();
+            }
+#endif // WEAR_LEVELING_CHECKPOINTS
             break;
 
         default:
@@ -726,6 +1604,47 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+/**
+ * Performs deferred wear-leveling work.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Don't consolidate uncommitted transaction data
+    if (wear_leveling.consolidation.state == CONSOLIDATION_IDLE || wear_leveling.transaction.depth > 0) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Check back on a later pass while a sector is still being erased
+    if (wear_leveling.consolidation.erasing && backing_store_erase_busy()) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_consolidation_step();
+
+    // Leave a sector erase running, the backing store stays unlocked until it's done
+    if (wear_leveling.consolidation.erasing) {
+        return status;
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+}
+
 /**
  * Reads logical data from the cache.
  */
@@ -755,6 +1674,15 @@ __attribute__((weak)) bool backing_store_read_bulk(uint32_t address, backing_sto
     return true;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Weak implementation of the erase status, for drivers whose sector erases only return once they're done.
+ */
+__attribute__((weak)) bool backing_store_erase_busy(void) {
+    return false;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 /**
  * Weak implementation of bulk write, drivers can implement more optimised implementations.
  */
@@ -32,9 +32,9 @@ wear_leveling_status_t wear_leveling_erase(void);
 /**
  * Writes logical data into the backing store.
  *
- * Skips writes if there are no changes to written values. The entire written block is considered when attempting to
- * determine if an overwrite should occur -- if there is any data mismatch the entire block will be written to the log,
- * not just the changed bytes.
+ * Skips writes if there are no changes to written values. Otherwise only the runs of changed bytes are written to the
+ * log, up to WEAR_LEVELING_WRITE_RUNS of them -- neighbouring runs are merged whenever logging the unchanged bytes in
+ * between is no more expensive, and the entire block is written instead if splitting it up doesn't save any space.
  *
  * @param address[in] the logical address to write data
  * @param value[in] pointer to the source buffer
@@ -43,6 +43,37 @@ wear_leveling_status_t wear_leveling_erase(void);
  */
 wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value, size_t length);
 
+/**
+ * Starts a wear-leveling transaction.
+ *
+ * Until the matching wear_leveling_transaction_commit(), writes only update the cache. Transactions may be nested, only
+ * the outermost commit writes to the backing store.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_transaction_begin(void);
+
+/**
+ * Commits a wear-leveling transaction.
+ *
+ * The data changed during the transaction is appended to the write log as a single unit, which is either played back in
+ * full or not at all after a power loss. If it doesn't fit into the rest of the write log, a consolidation occurs
+ * instead.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_transaction_commit(void);
+
+/**
+ * Performs deferred wear-leveling work, such as a step of an incremental consolidation.
+ *
+ * Intended to be called periodically outside of time-critical code, does nothing unless
+ * WEAR_LEVELING_INCREMENTAL_CONSOLIDATION is enabled.
+ *
+ * @return Status of the request, WEAR_LEVELING_CONSOLIDATED once a consolidation completes
+ */
+wear_leveling_status_t wear_leveling_task(void);
+
 /**
  * Reads logical data from the cache.
  *
@@ -66,6 +66,15 @@ _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+// The backing store is split into two banks, each with its own consolidated data and write log
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+_Static_assert(WEAR_LEVELING_BACKING_SIZE % (WEAR_LEVELING_LOGICAL_SIZE * 2) == 0, "Bank size must be a multiple of logical size");
+_Static_assert(WEAR_LEVELING_BANK_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Bank size must be at least twice the size of the logical size");
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
@@ -75,6 +84,10 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, siz
 bool backing_store_lock(void);
 bool backing_store_read(uint32_t address, backing_store_int_t* value);
 bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_sector(uint32_t address, uint32_t* length); // starts erasing the sector at address and reports its length, banks need to be sector-aligned
+bool backing_store_erase_busy(void);                                 // whether the last sector erase is still running, weak implementation reports it done
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Helper type used to contain a write log entry.
@@ -101,6 +114,9 @@ enum {
     // 0x02 -- 2-byte backing store write optimization: word-encoded 0/1 values
     LOG_ENTRY_TYPE_WORD_01,
 
+    // 0x03 -- Extended entry, further discriminated by a subtype
+    LOG_ENTRY_TYPE_EXTENDED,
+
     LOG_ENTRY_TYPES
 };
 
@@ -149,3 +165,43 @@ _Static_assert(LOG_ENTRY_TYPES <= (1 << 2), "Too many log entry types to fit int
             [1] = (uint8_t)((address) >> 1), /* address */                                            \
         }                                                                                             \
     }
+
+/**
+ * Extended log entry subtype discriminator.
+ */
+enum {
+    // 0x00 -- Start of a transaction, argument is the length in bytes of the log entries up to the matching commit
+    LOG_ENTRY_EXTENDED_TRANSACTION_BEGIN,
+
+    // 0x01 -- End of a transaction, argument is the folded FNV1a_32 of the transaction's log entries
+    LOG_ENTRY_EXTENDED_TRANSACTION_COMMIT,
+
+    // 0x02 -- First entry of a bank's write log, argument is the bank's sequence number
+    LOG_ENTRY_EXTENDED_BANK_SEQUENCE,
+
+    // 0x03 -- Start of a checkpoint, argument is the length in bytes of the log entries up to the matching commit
+    LOG_ENTRY_EXTENDED_CHECKPOINT_BEGIN,
+
+    // 0x04 -- End of a checkpoint, argument is the folded FNV1a_32 of the whole cache
+    LOG_ENTRY_EXTENDED_CHECKPOINT_COMMIT,
+
+    LOG_ENTRY_EXTENDED_TYPES
+};
+
+_Static_assert(LOG_ENTRY_EXTENDED_TYPES <= (1 << 6), "Too many extended log entry types to fit into 6 bits of storage");
+
+#define LOG_ENTRY_EXTENDED_SIZE ((BACKING_STORE_WRITE_SIZE) > 4 ? (BACKING_STORE_WRITE_SIZE) : 4)
+#define LOG_ENTRY_EXTENDED_MAX_ARGUMENT BITMASK_FOR_BITCOUNT(24)
+#define LOG_ENTRY_EXTENDED_GET_SUBTYPE(entry) ((uint8_t)((entry).raw8[0] & BITMASK_FOR_BITCOUNT(6)))
+#define LOG_ENTRY_EXTENDED_GET_ARGUMENT(entry) ((((uint32_t)((entry).raw8[1])) << 16) | (((uint32_t)((entry).raw8[2])) << 8) | (entry).raw8[3])
+#define LOG_ENTRY_MAKE_EXTENDED(subtype, argument)                                                      \
+    (write_log_entry_t) {                                                                               \
+        .raw8 = {                                                                                       \
+            [0] = (((((uint8_t)LOG_ENTRY_TYPE_EXTENDED) & BITMASK_FOR_BITCOUNT(2)) << 6) /* type */     \
+                   | ((((uint8_t)(subtype))) & BITMASK_FOR_BITCOUNT(6))                  /* subtype */  \
+                   ),                                                                                   \
+            [1] = (((uint8_t)((argument) >> 16)) & BITMASK_FOR_BITCOUNT(8)), /* argument */             \
+            [2] = (((uint8_t)((argument) >> 8)) & BITMASK_FOR_BITCOUNT(8)),  /* argument */             \
+            [3] = (((uint8_t)(argument)) & BITMASK_FOR_BITCOUNT(8)),         /* argument */             \
+        }                                                                                               \
+    }
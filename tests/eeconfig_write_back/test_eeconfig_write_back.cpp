@@ -0,0 +1,96 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+#include "suspend.h"
+}
+
+class EeconfigWriteBack : public TestFixture {
+   public:
+    void SetUp() override {
+        eeconfig_update_user(0);
+        eeconfig_flush();
+    }
+
+    // The value actually stored, bypassing the write-back cache
+    static uint32_t stored_user(void) {
+        return eeprom_read_dword(EECONFIG_USER);
+    }
+};
+
+TEST_F(EeconfigWriteBack, repeated_updates_are_written_once_idle) {
+    for (uint32_t i = 1; i <= 50; ++i) {
+        eeconfig_update_user(i);
+        run_one_scan_loop();
+    }
+
+    EXPECT_EQ(stored_user(), 0);
+    EXPECT_EQ(eeconfig_read_user(), 50);
+
+    idle_for(EECONFIG_WRITE_BACK_TIMEOUT);
+    EXPECT_EQ(stored_user(), 50);
+    EXPECT_EQ(eeconfig_read_user(), 50);
+}
+
+TEST_F(EeconfigWriteBack, updates_restart_idle_timeout) {
+    eeconfig_update_user(1);
+    idle_for(EECONFIG_WRITE_BACK_TIMEOUT / 2);
+    eeconfig_update_user(2);
+    idle_for(EECONFIG_WRITE_BACK_TIMEOUT / 2 + 10);
+    EXPECT_EQ(stored_user(), 0);
+
+    idle_for(EECONFIG_WRITE_BACK_TIMEOUT / 2);
+    EXPECT_EQ(stored_user(), 2);
+}
+
+TEST_F(EeconfigWriteBack, unchanged_value_is_not_held) {
+    eeconfig_update_user(0);
+    eeconfig_update_user(7);
+    eeconfig_update_user(0);
+    EXPECT_EQ(eeconfig_read_user(), 0);
+
+    idle_for(EECONFIG_WRITE_BACK_TIMEOUT);
+    EXPECT_EQ(stored_user(), 0);
+}
+
+TEST_F(EeconfigWriteBack, suspend_flushes) {
+    eeconfig_update_user(0x1234);
+    suspend_power_down_quantum();
+    EXPECT_EQ(stored_user(), 0x1234);
+}
+
+TEST_F(EeconfigWriteBack, full_cache_flushes) {
+    uint8_t debug     = 0x5A;
+    uint8_t audio     = 0x01;
+    uint8_t backlight = 0x02;
+    uint8_t steno     = 0x03;
+    eeconfig_update_block(&debug, EECONFIG_DEBUG, sizeof(debug));
+    eeconfig_update_block(&audio, EECONFIG_AUDIO, sizeof(audio));
+    eeconfig_update_block(&backlight, EECONFIG_BACKLIGHT, sizeof(backlight));
+    eeconfig_update_block(&steno, EECONFIG_STENOMODE, sizeof(steno));
+    EXPECT_EQ(stored_user(), 0);
+
+    // A fifth region writes out the first four
+    eeconfig_update_user(0x42);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEBUG), 0x5A);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_STENOMODE), 0x03);
+    EXPECT_EQ(stored_user(), 0);
+
+    eeconfig_flush();
+    EXPECT_EQ(stored_user(), 0x42);
+}
+
+TEST_F(EeconfigWriteBack, partial_overlap_keeps_order) {
+    eeconfig_update_user(0x11223344);
+    uint8_t patch = 0xAA;
+    eeconfig_update_block(&patch, (uint8_t *)EECONFIG_USER + 1, sizeof(patch));
+
+    EXPECT_EQ(stored_user(), 0x11223344);
+    EXPECT_EQ(eeconfig_read_user(), 0x1122AA44);
+
+    eeconfig_flush();
+    EXPECT_EQ(stored_user(), 0x1122AA44);
+}